@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace GW2_SCT {
+	// FIFO of messages waiting to be displayed, indexed by combine key so that finding the message a new hit
+	// combines into does not walk the queue. The index points at the newest entry of each key and entries of
+	// one key are linked to each other, so removing any entry hands the index on to the next older one, which
+	// is the entry a backward walk over the queue would have found.
+	template <class T, class Key, class KeyHash>
+	class CombineQueue {
+	public:
+		static constexpr uint64_t noSeq = std::numeric_limits<uint64_t>::max();
+
+		struct Entry {
+			T value;
+			Key key;
+			uint64_t seq = 0;          // increasing from front to back
+			uint64_t olderSeq = noSeq; // closest entry with the same key towards the front
+			uint64_t newerSeq = noSeq; // closest entry with the same key towards the back
+		};
+		using iterator = typename std::deque<Entry>::iterator;
+
+		bool empty() const { return entries.empty(); }
+		size_t size() const { return entries.size(); }
+		iterator begin() { return entries.begin(); }
+		iterator end() { return entries.end(); }
+		Entry& front() { return entries.front(); }
+		Entry& back() { return entries.back(); }
+
+		void push(const Key& key, T value) {
+			Entry entry{ std::move(value), key, nextSeq++ };
+			auto [indexed, inserted] = newest.try_emplace(key, entry.seq);
+			if (!inserted) {
+				entry.olderSeq = indexed->second;
+				findSeq(indexed->second)->newerSeq = entry.seq;
+				indexed->second = entry.seq;
+			}
+			entries.push_back(std::move(entry));
+		}
+
+		// Newest entry with the key, end() if none is queued
+		iterator findNewest(const Key& key) {
+			auto indexed = newest.find(key);
+			return indexed != newest.end() ? findSeq(indexed->second) : entries.end();
+		}
+
+		// The value of a removed entry may have been moved from, its key and links are still intact
+		void popFront() {
+			unlink(entries.front());
+			entries.pop_front();
+		}
+		void popBack() {
+			unlink(entries.back());
+			entries.pop_back();
+		}
+		iterator erase(iterator it) {
+			unlink(*it);
+			return entries.erase(it);
+		}
+
+	private:
+		// Linked entries are always queued, so this only misses for seqs that were never linked
+		iterator findSeq(uint64_t seq) {
+			auto it = std::lower_bound(entries.begin(), entries.end(), seq, [](const Entry& entry, uint64_t s) { return entry.seq < s; });
+			return it != entries.end() && it->seq == seq ? it : entries.end();
+		}
+
+		void unlink(const Entry& entry) {
+			if (entry.olderSeq != noSeq) findSeq(entry.olderSeq)->newerSeq = entry.newerSeq;
+			if (entry.newerSeq != noSeq) {
+				findSeq(entry.newerSeq)->olderSeq = entry.olderSeq;
+			}
+			else if (entry.olderSeq != noSeq) {
+				newest.find(entry.key)->second = entry.olderSeq;
+			}
+			else {
+				newest.erase(entry.key);
+			}
+		}
+
+		std::deque<Entry> entries;
+		std::unordered_map<Key, uint64_t, KeyHash> newest;
+		uint64_t nextSeq = 0;
+	};
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "CombatTypes.h"
+
+namespace GW2_SCT {
+	// Message types and corrected values of one combat event. An event maps to at most
+	// a barrier part (SHIELD_*) and a value part.
+	struct ClassifiedEvent {
+		static constexpr size_t maxTypes = 2;
+
+		std::array<MessageType, maxTypes> types = {};
+		uint8_t typeCount = 0;
+		int32_t value = 0;     // direct value, with the absorbed part added back for barrier hits
+		int32_t buffValue = 0; // buff value, with the barrier part removed
+
+		constexpr void add(MessageType type) {
+			if (type != MessageType::NONE) types[typeCount++] = type;
+		}
+	};
+
+	namespace EventClassifierTables {
+		// Indexed by cbtevent1::result, NONE for results that are not shown
+		constexpr std::array<MessageType, 256> resultTypes = [] {
+			std::array<MessageType, 256> table = {};
+			table[CBTR_NORMAL] = MessageType::PHYSICAL;
+			table[CBTR_GLANCE] = MessageType::PHYSICAL;
+			table[CBTR_INTERRUPT] = MessageType::PHYSICAL;
+			table[CBTR_CRIT] = MessageType::CRIT;
+			table[CBTR_BLOCK] = MessageType::BLOCK;
+			table[CBTR_EVADE] = MessageType::EVADE;
+			table[CBTR_ABSORB] = MessageType::INVULNERABLE;
+			table[CBTR_BLIND] = MessageType::MISS;
+			return table;
+		}();
+
+		struct ConditionType {
+			uint32_t skillId;
+			MessageType type;
+		};
+		constexpr std::array<ConditionType, 5> conditionTypes = { {
+			{ 736, MessageType::BLEEDING },
+			{ 737, MessageType::BURNING },
+			{ 723, MessageType::POISON },
+			{ 861, MessageType::CONFUSION },
+			{ 19426, MessageType::TORMENT }
+		} };
+
+		constexpr MessageType conditionType(uint32_t skillId) {
+			for (const ConditionType& condition : conditionTypes) {
+				if (condition.skillId == skillId) return condition.type;
+			}
+			return MessageType::DOT;
+		}
+	}
+
+	// Pure classification of a (non statechange/activation/buffremove) event, the event itself is not touched.
+	constexpr ClassifiedEvent classifyCombatEvent(const cbtevent1& ev) {
+		ClassifiedEvent ret;
+		ret.value = ev.value;
+		ret.buffValue = ev.buff_dmg;
+		// arcdps reports overstack as unsigned, keep the wrap-around semantics of the raw event arithmetic
+		const auto withOverstack = [&ev](int32_t v, bool add) {
+			uint32_t raw = static_cast<uint32_t>(v);
+			return static_cast<int32_t>(add ? raw + ev.overstack_value : raw - ev.overstack_value);
+		};
+
+		if (ev.buff) {
+			// Buff-based effects (DoT, HoT, etc.)
+			if (ret.buffValue > 0) {
+				if (ev.overstack_value != 0) {
+					ret.buffValue = withOverstack(ret.buffValue, false);
+					ret.add(MessageType::SHIELD_RECEIVE);
+				}
+				if (ret.buffValue > 0) ret.add(MessageType::HOT);
+			}
+			else if (ret.buffValue < 0) {
+				if (ev.overstack_value != 0) {
+					ret.buffValue = withOverstack(ret.buffValue, true);
+					ret.add(MessageType::SHIELD_REMOVE);
+				}
+				if (ret.buffValue < 0) ret.add(EventClassifierTables::conditionType(ev.skillid));
+			}
+		}
+		else if (ret.value > 0) {
+			// Healing, or barrier if overstacked
+			ret.add(ev.overstack_value != 0 ? MessageType::SHIELD_RECEIVE : MessageType::HEAL);
+		}
+		else {
+			// Direct damage, partially or fully absorbed by barrier
+			if (ev.overstack_value != 0) {
+				ret.value = withOverstack(ret.value, true);
+				ret.add(MessageType::SHIELD_REMOVE);
+			}
+			if (ev.overstack_value == 0 || ret.value < 0) {
+				ret.add(EventClassifierTables::resultTypes[ev.result]);
+			}
+		}
+		return ret;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EventRecord.h"
+
+namespace GW2_SCT {
+	struct EventCoalescerStats {
+		uint64_t added = 0;
+		uint64_t folded = 0; // records merged into an already pending record
+	};
+
+	// Folds drained records that would end up as the same messages (same categories, types, skill
+	// and agents) into one record, summing their values and hit counts. Pending records keep the
+	// order of their first hit. Only used by the UI thread while it drains the incoming queue, so
+	// producers never see it; all storage is allocated up front.
+	class EventCoalescer {
+	public:
+		EventCoalescer(size_t maxPending);
+
+		bool full() const { return pending.size() >= maxPending; }
+		// Must not be called when full
+		void add(const EventRecord& record);
+		const std::vector<EventRecord>& pendingRecords() const { return pending; }
+		// Removes the first count pending records once they were routed, the rest can still be folded into
+		void consume(size_t count);
+		EventCoalescerStats getStats() const { return stats; }
+
+	private:
+		struct Key {
+			uint64_t src;
+			uint64_t dst;
+			uint32_t skillId;
+			uint32_t shape; // categories and types
+			bool operator==(const Key& other) const = default;
+		};
+		// A slot is in use if its generation is the current one, so the table is cleared by bumping it
+		struct Slot {
+			Key key;
+			uint32_t generation = 0;
+			uint32_t index = 0;
+		};
+		static Key keyOf(const EventRecord& record);
+		static size_t hashOf(const Key& key);
+		void index(const Key& key, uint32_t index);
+
+		size_t maxPending;
+		std::vector<EventRecord> pending;
+		std::vector<Slot> table; // open addressing, at least twice maxPending
+		uint32_t generation = 1;
+		EventCoalescerStats stats;
+	};
+}
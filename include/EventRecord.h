@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "CombatTypes.h"
+#include "StringInterner.h"
+
+namespace GW2_SCT {
+	struct EventAgent {
+		uint64_t id = 0;
+		uint32_t prof = 0;
+		InternedString name = 0;
+	};
+
+	// Fixed-size snapshot of one classified combat event, built on the arcdps callback thread and
+	// carried by value through the ingest queue. It lists every category and type the event is
+	// delivered as. Names are interned handles, so creating and copying a record never touches the heap.
+	struct EventRecord {
+		static constexpr size_t maxTypes = 2;
+		static constexpr size_t maxCategories = 2; // at most one outgoing and one incoming
+
+		std::chrono::system_clock::time_point timepoint;
+		std::array<MessageType, maxTypes> types = {};
+		std::array<MessageCategory, maxCategories> categories = {};
+		uint8_t typeCount = 0;
+		uint8_t categoryCount = 0;
+		int32_t value = 0;
+		uint32_t overstack_value = 0;
+		int32_t buffValue = 0;
+		uint32_t skillId = 0;
+		InternedString skillName = 0;
+		EventAgent src;
+		EventAgent dst;
+		uint32_t hitCount = 1; // > 1 if same-skill hits were folded into this record before routing
+	};
+	static_assert(std::is_trivially_copyable_v<EventRecord>, "EventRecord has to stay trivially copyable");
+
+	inline bool isIncomingCategory(MessageCategory category) {
+		return category == MessageCategory::PLAYER_IN || category == MessageCategory::PET_IN;
+	}
+
+	// The hot settings the arcdps thread reads per event, see Options::combatHot
+	struct CombatHotOptions {
+		bool selfMessageOnlyIncoming = false;
+		bool outgoingOnlyToTarget = false;
+	};
+
+	// What the combat callbacks learn about the player between events
+	struct EventIngestState {
+		uint64_t selfInstId = UINT64_MAX;
+		uint64_t targetAgentId = UINT64_MAX;
+	};
+
+	// Names shown when arcdps reports none, only looked up for events that are shown
+	enum class UnknownName {
+		SKILL,
+		SOURCE,
+		TARGET
+	};
+	using UnknownNameFunction = const char* (*)(UnknownName name);
+
+	// The local combat callback's work on a revision 1 event up to queueing it: tracks the player's
+	// instance id, classifies the event and selects the categories it is shown in, then interns the
+	// names. Returns false if the event is not shown. The skill id is left as reported, remapping it
+	// is up to the caller.
+	bool buildEventRecord(EventIngestState& state, CombatHotOptions options, const cbtevent1& ev, const ag& src, const ag& dst, const char* skillname, UnknownNameFunction unknownName, EventRecord& record);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CombatTypes.h"
+
+namespace GW2_SCT {
+	// Layout of an arcdps log, see the evtc notes in the arcdps readme
+	struct EvtcLog {
+		struct Agent {
+			uint64_t addr;
+			uint32_t prof;
+			uint32_t elite;
+			std::string name;
+		};
+		std::vector<Agent> agents;
+		std::unordered_map<uint64_t, size_t> agentIndex;
+		std::unordered_map<uint32_t, std::string> skillNames;
+		std::vector<cbtevent1> events;
+		uint64_t povAddr = 0;
+
+		// Uncompressed logs of revision 1 only, nullptr and a reason in error otherwise
+		static std::shared_ptr<EvtcLog> parse(const std::vector<char>& data, std::string& error);
+	};
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "Common.h"
+#include "SCTMain.h"
+
+namespace GW2_SCT {
+	struct EvtcLog;
+
+	struct EvtcReplayStats {
+		bool running = false;
+		uint64_t eventsTotal = 0;
+		uint64_t eventsReplayed = 0;
+		uint64_t ingestNanos = 0; // time spent inside CombatEventLocal
+		uint64_t ingestAllocations = 0; // heap allocations made inside CombatEventLocal, only counted by the debug heap of _DEBUG builds
+		double elapsedSeconds = 0;
+		double eventsPerSecond() const { return elapsedSeconds > 0 ? eventsReplayed / elapsedSeconds : 0; }
+		double ingestNanosPerEvent() const { return eventsReplayed > 0 ? double(ingestNanos) / eventsReplayed : 0; }
+		double ingestAllocationsPerEvent() const { return eventsReplayed > 0 ? double(ingestAllocations) / eventsReplayed : 0; }
+	};
+
+	// Feeds the combat events of an arcdps log (uncompressed .evtc, revision 1) through
+	// SCTMain::CombatEventLocal, either as fast as possible or at the recorded pacing.
+	// The log's point of view agent is reported as self.
+	class EvtcReplay {
+	public:
+		static void setMain(SCTMain* m) { main = m; };
+		static bool start(const std::string& path, bool recordedPacing);
+		static void stop();
+		static bool isRunning() { return running; };
+		static EvtcReplayStats getStats();
+		static const std::string& getLastError() { return lastError; };
+	private:
+		static void replay(std::shared_ptr<const EvtcLog> evtc, bool recordedPacing);
+		static SCTMain* main;
+		static std::thread* replayThread;
+		static std::atomic<bool> running;
+		static std::atomic<bool> stopRequested;
+		static std::atomic<uint64_t> eventsTotal;
+		static std::atomic<uint64_t> eventsReplayed;
+		static std::atomic<uint64_t> ingestNanos;
+		static std::atomic<uint64_t> ingestAllocations;
+		static std::atomic<int64_t> startNanos;
+		static std::atomic<int64_t> endNanos;
+		static std::string lastError;
+	};
+}
@@ -13,24 +13,19 @@ namespace GW2_SCT {
 		static void paint();
 		static void open();
 		static void setMain(SCTMain* m) { main = m; };
-		static void receiveMessage(std::shared_ptr<EventMessage>);
+		static void receiveMessage(const EventRecord& record);
 	private:
 		enum State {
 			READY_TO_RECORD,
 			RECORDING,
 			EMITTING
 		};
-		struct MessageInformation {
-			MessageCategory category;
-			MessageType type;
-			std::shared_ptr<MessageData> data;
-		};
 		static void emitMessages();
 		static bool windowIsOpen;
 		static State state;
 		static std::chrono::system_clock::time_point recordingStart;
 		static SCTMain* main;
-		static std::multimap<std::chrono::system_clock::duration, MessageInformation> messagesToEmmit;
+		static std::multimap<std::chrono::system_clock::duration, EventRecord> messagesToEmmit;
 		static std::thread* emitterThread;
 	};
 }
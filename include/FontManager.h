@@ -51,6 +51,13 @@ namespace GW2_SCT {
 
     class FontType {
     public:
+        // One glyph of a laid out text, offsets relative to the position the text is drawn at
+        struct GlyphQuad {
+            Texture* texture = nullptr;
+            ImVec2 offset{}, size{};
+            ImVec2 uvStart{}, uvEnd{};
+        };
+
         FontType(unsigned char* data, size_t size);
 
         static void ensureAtlasCreation();
@@ -60,6 +67,9 @@ namespace GW2_SCT {
         ImVec2 calcRequiredSpaceForTextAtSize(std::string text, float fontSize);
         void bakeGlyphsAtSize(std::string text, float fontSize);
         void drawAtSize(std::string text, float fontSize, ImVec2 position, ImU32 color);
+        // Appends the quads of text at fontSize to out, the glyphs have to be baked already
+        void layoutAtSize(const std::string& text, float fontSize, std::vector<GlyphQuad>& out);
+        static void drawLayout(const std::vector<GlyphQuad>& quads, ImVec2 position, ImU32 color);
 #if _DEBUG
         void drawAtlas();
 #endif
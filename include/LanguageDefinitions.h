@@ -159,6 +159,22 @@
   F(General_Self_Only_As_Incoming_Toolip,)\
   F(General_Out_Only_For_Target,)\
   F(General_Out_Only_For_Target_Toolip,)\
+  F(General_Coalesce_Events,)\
+  F(General_Coalesce_Events_Toolip,)\
+  F(General_Overload_Mode,)\
+  F(General_Overload_Mode_Toolip,)\
+  F(General_Overload_Mode_Off,)\
+  F(General_Overload_Mode_Drop_Lowest,)\
+  F(General_Overload_Mode_Drop_Oldest,)\
+  F(General_Overload_Mode_Collapse,)\
+  F(General_Overload_Queue_Depth,)\
+  F(General_Overload_Frame_Budget,)\
+  F(General_Overload_Frame_Budget_Toolip,)\
+  F(General_Overload_Counters,)\
+  F(General_Number_Format,)\
+  F(General_Number_Format_Toolip,)\
+  F(General_Draw_Counters,)\
+  F(General_Overload_More,)\
   F(Update_Menu_Header,)\
   F(Update_Mode_Off,)\
   F(Update_Mode_OnStable,)\
@@ -252,8 +268,20 @@
   F(New_Receiver,)\
   F(Merge_Crit_With_Hit,)\
   F(Merge_Crit_With_Hit_Tooltip,)\
+  F(Combine_Window,)\
+  F(Combine_Window_Tooltip,)\
   F(Template,)\
   F(Available_Parameters,)\
+  F(Template_Error_At,)\
+  F(Template_Error_Lone_Closing_Bracket,)\
+  F(Template_Error_Unterminated_Tag,)\
+  F(Template_Error_Unknown_Tag,)\
+  F(Template_Error_Missing_Tag_Value,)\
+  F(Template_Error_Invalid_Color,)\
+  F(Template_Error_Invalid_Icon,)\
+  F(Template_Error_Unexpected_Closing_Tag,)\
+  F(Template_Error_Unclosed_Tag,)\
+  F(Template_Error_Unknown_Parameter,)\
   F(Delete_Confirmation_Title,)\
   F(Delete_Confirmation_Content,)\
   F(Delete_Confirmation_Confirmation,)\
@@ -289,6 +317,7 @@
   F(Add_Filter_Button_Text,)\
   F(Used_By_Label,)\
   F(Not_Assigned_Info,)\
+  F(Filter_Cache_Hit_Rate,)\
   F(Select_Filter_Set_Hint_Line1,)\
   F(Select_Filter_Set_Hint_Line2,)\
   F(Profile_Description,)\
@@ -6,15 +6,26 @@
 #include <vector>
 #include <map>
 #include <chrono>
-#include "Common.h"
-#include "Options.h"
+#include <array>
+#include <type_traits>
+#include <string_view>
+#include "CombatTypes.h"
+#include "NumberFormat.h"
+#include "StringInterner.h"
+#include "EventRecord.h"
+#include "TemplateParser.h"
+
+// Appends the initials of a skill name of several words, other names as they are
+void AppendAbbreviatedSkillName(std::string& out, std::string_view skillName);
+std::string AbbreviateSkillName(const std::string& skillName);
 
 namespace GW2_SCT {
+    struct message_receiver_options_struct;
 
     struct MessageData {
-        char* skillName = nullptr;
-        char* entityName = nullptr;
-        char* otherEntityName = nullptr;
+        InternedString skillName = 0;
+        InternedString entityName = 0;
+        InternedString otherEntityName = 0;
         int32_t value = 0;
         uint32_t overstack_value = 0;
         int32_t buffValue = 0;
@@ -23,55 +34,124 @@ namespace GW2_SCT {
         uint32_t entityProf = 0;
         uint64_t otherEntityId = 0;
         uint32_t otherEntityProf = 0;
+        uint32_t hitCount = 1;
         bool hasToBeFiltered = false;
 
     public:
-        MessageData(cbtevent* ev, ag* entity, ag* otherEntity, const char* skillname);
-        MessageData(cbtevent1* ev, ag* entity, ag* otherEntity, const char* skillname);
-#ifdef _DEBUG
-        MessageData(int32_t value, int32_t buffValue, uint32_t overstack_value, uint32_t skillId, ag* entity, ag* otherEntity, const char* skillname);
-#endif
+        // Seen from the given category: outgoing messages are about the target, incoming ones about the source
+        MessageData(const EventRecord& record, MessageCategory category);
         MessageData() {}
-        MessageData(const MessageData& toCopy);  // deep copy (char* fields duplicated)
-        ~MessageData();                          // frees char* fields
     };
 
-    // Const view used by handler functions
-    using DataVecView = std::vector<std::shared_ptr<const MessageData>>;
+    // One (category, type) delivery of an ingested event. The payload is shared by all deliveries
+    // of the same event from the same perspective and must not be modified.
+    struct RoutedMessage {
+        MessageCategory category;
+        MessageType type;
+        std::shared_ptr<const MessageData> payload;
+        std::chrono::system_clock::time_point timepoint;
+    };
+
+    // Running totals of every payload combined into one message. The first payload provides
+    // names and ids, so a message keeps constant size no matter how many hits it absorbs.
+    struct MessageAggregate {
+        std::shared_ptr<const MessageData> first;
+        int32_t value = 0;
+        int32_t buffValue = 0;
+        int32_t overstackValue = 0;
+        // Sum of the per payload magnitudes used by thresholds, see EventMessage::getCombinedValue
+        int32_t combinedValue = 0;
+        uint32_t hitCount = 0;
+        // False once a payload from a differently named entity was added
+        bool entityNameUniform = true;
+
+        void add(MessageType type, const MessageData& data);
+    };
+
+    // Localized text a rendered message can contain besides its names
+    enum class MessageText {
+        MULTIPLE_SOURCES,
+        NUMBER_OF_HITS
+    };
+
+    // Everything rendering reads besides the compiled template and the message. The addon fills it
+    // from the receiver, the hot options and the language file, see writeStringForOptions. The
+    // functions are only called for messages that show their text and must all be set.
+    struct MessageRenderOptions {
+        NumberFormat numberFormat;
+        bool skillIconsEnabled = true;
+        bool abbreviateSkillNames = false;
+        int numberShortPrecision = -1; // -1 writes whole numbers
+        bool showCombinedHitCount = false;
+        const char* (*text)(MessageText text) = nullptr;
+        const char* (*professionName)(uint32_t prof) = nullptr;
+        const char* (*professionColor)(uint32_t prof) = nullptr;
+    };
+
+    using CombineFunction = bool (*)(const MessageData& srcData, const MessageData& targetData);
+    // Appends the placeholder's text to out, so formatting a message only grows one buffer
+    using ParameterFunction = void (*)(const MessageAggregate& data, const MessageRenderOptions& options, std::string& out);
 
+    // Behaviour of one (category, type): the checks that must all pass to combine two messages and
+    // a jump table from template placeholder character to formatter, nullptr where unused.
     struct MessageHandler {
-        std::vector<std::function<bool(const DataVecView&, const DataVecView&)>> tryToCombineWithFunctions;
-        std::map<char, std::function<std::string(const DataVecView&)>> parameterToStringFunctions;
+        static constexpr size_t maxCombineFunctions = 2;
 
-        MessageHandler(
-            std::vector<std::function<bool(const DataVecView&, const DataVecView&)>> tryToCombineWithFunctions,
-            std::map<char, std::function<std::string(const DataVecView&)>> parameterToStringFunctions
-        );
+        std::array<CombineFunction, maxCombineFunctions> combineFunctions = {};
+        std::array<ParameterFunction, 256> parameterFunctions = {};
+    };
+
+    // A receiver's outputTemplate and color compiled for one (category, type). Literal text,
+    // including the color markup, is stored once and referenced by span; placeholders are
+    // resolved to their formatter so rendering a message only runs the op list.
+    struct CompiledTemplate {
+        enum class OpCode : uint8_t {
+            LITERAL,   // text[offset, offset + length)
+            PARAMETER, // parameter(aggregate, out)
+            ICON,      // skill icon markup, if skill icons are enabled
+            HIT_COUNT  // "[[N hits]]" suffix of combined messages, if enabled on the receiver
+        };
+        struct Op {
+            OpCode code;
+            uint32_t offset = 0;
+            uint32_t length = 0;
+            ParameterFunction parameter = nullptr;
+        };
+
+        std::string text;
+        std::vector<Op> ops;
+        // Why and where the output template could not be parsed, see TemplateParser::describeError
+        TemplateError error = TemplateError::NONE;
+        size_t errorPosition = 0;
+
+        static std::shared_ptr<const CompiledTemplate> compile(const std::string& outputTemplate, const std::string& color, MessageCategory category, MessageType type);
     };
 
     class EventMessage {
     public:
-        EventMessage(MessageCategory category, MessageType type, cbtevent* ev, ag* src, ag* dst, char* skillname);
-        EventMessage(MessageCategory category, MessageType type, cbtevent1* ev, ag* src, ag* dst, char* skillname);
-        EventMessage(MessageCategory category, MessageType type, std::shared_ptr<MessageData>);
+        EventMessage(MessageCategory category, MessageType type, std::shared_ptr<const MessageData> data, std::chrono::system_clock::time_point timepoint);
 
-        std::string getStringForOptions(std::shared_ptr<message_receiver_options_struct> opt);
-        std::shared_ptr<MessageData> getCopyOfFirstData();
+        // Renders the message into out, replacing its contents but keeping its capacity
+        void render(const CompiledTemplate& compiled, const MessageRenderOptions& options, std::string& out) const;
+        // render with the receiver's template and settings, defined with the addon's options in MessageOptions.cpp
+        void writeStringForOptions(const std::shared_ptr<message_receiver_options_struct>& opt, std::string& out);
+        // Read only access to the payloads without copying them, the first data is nullptr for an empty message
+        const MessageData* getFirstData() const { return aggregate.first.get(); }
+        const MessageAggregate& getAggregate() const { return aggregate; }
         int32_t getCombinedValue() const;
-        MessageCategory getCategory();
-        MessageType getType();
+        MessageCategory getCategory() const;
+        MessageType getType() const;
         bool hasToBeFiltered();
-        bool tryToCombineWith(std::shared_ptr<EventMessage> m);
+        bool tryToCombineWith(MessageCategory otherCategory, MessageType otherType, const std::shared_ptr<const MessageData>& data);
         std::chrono::system_clock::time_point getTimepoint();
+        uint32_t getHitCount() const;
 
     private:
         std::chrono::system_clock::time_point timepoint;
         MessageCategory category;
         MessageType type;
-        // OWNED data (no dangling pointers)
-        std::vector<std::shared_ptr<MessageData>> messageDatas;
-
-        static std::map<MessageCategory, std::map<MessageType, MessageHandler>> messageHandlers;
+        // First payload is shared with other messages built from the same event and must not be modified
+        MessageAggregate aggregate;
     };
 
 } // namespace GW2_SCT
@@ -0,0 +1,163 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace GW2_SCT {
+	enum class RingOverflowPolicy {
+		DROP_NEWEST = 0, // reject the element that did not fit
+		DROP_OLDEST      // evict the oldest unread element to make room
+	};
+
+	struct RingBufferStats {
+		uint64_t pushed = 0;
+		uint64_t popped = 0;
+		uint64_t dropped = 0;
+		size_t highWaterMark = 0;
+		size_t capacity = 0;
+	};
+
+	// Bounded lock-free ring buffer (per-slot sequence numbers, see D. Vyukov's bounded MPMC queue).
+	// Any number of threads may push, one thread is expected to drain. The dequeue side is still safe
+	// against concurrent use so producers can evict the oldest element under DROP_OLDEST.
+	template <class T, size_t Capacity>
+	class MpscRingBuffer {
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscRingBuffer capacity must be a power of two");
+		static_assert(std::is_nothrow_move_constructible_v<T>, "MpscRingBuffer elements must be nothrow move constructible");
+	public:
+		MpscRingBuffer(RingOverflowPolicy policy = RingOverflowPolicy::DROP_NEWEST) : overflowPolicy(policy) {
+			for (size_t i = 0; i < Capacity; i++) {
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+		~MpscRingBuffer() {
+			while (pop()) {}
+		}
+		MpscRingBuffer(const MpscRingBuffer&) = delete;
+		MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+		void setOverflowPolicy(RingOverflowPolicy policy) { overflowPolicy.store(policy, std::memory_order_relaxed); }
+		RingOverflowPolicy getOverflowPolicy() const { return overflowPolicy.load(std::memory_order_relaxed); }
+
+		// Returns false if the element was dropped because the ring was full.
+		bool push(T value) {
+			for (;;) {
+				if (tryPush(value)) {
+					pushedCount.fetch_add(1, std::memory_order_relaxed);
+					updateHighWaterMark();
+					return true;
+				}
+				if (overflowPolicy.load(std::memory_order_relaxed) != RingOverflowPolicy::DROP_OLDEST) {
+					droppedCount.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				// Discard the oldest element and try again; the consumer may have freed a slot meanwhile
+				if (tryPop()) {
+					droppedCount.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		std::optional<T> pop() {
+			std::optional<T> result = tryPop();
+			if (result) {
+				poppedCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			return result;
+		}
+
+		// Approximate; exact only when no producer is active.
+		size_t size() const {
+			size_t enqueue = enqueuePos.load(std::memory_order_acquire);
+			size_t dequeue = dequeuePos.load(std::memory_order_acquire);
+			return enqueue >= dequeue ? enqueue - dequeue : 0;
+		}
+		bool empty() const { return size() == 0; }
+		static constexpr size_t capacity() { return Capacity; }
+
+		RingBufferStats getStats() const {
+			RingBufferStats stats;
+			stats.pushed = pushedCount.load(std::memory_order_relaxed);
+			stats.popped = poppedCount.load(std::memory_order_relaxed);
+			stats.dropped = droppedCount.load(std::memory_order_relaxed);
+			stats.highWaterMark = highWaterMark.load(std::memory_order_relaxed);
+			stats.capacity = Capacity;
+			return stats;
+		}
+		void resetHighWaterMark() { highWaterMark.store(size(), std::memory_order_relaxed); }
+
+	private:
+		struct Slot {
+			std::atomic<size_t> sequence;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		std::optional<T> tryPop() {
+			Slot* slot;
+			size_t pos = dequeuePos.load(std::memory_order_relaxed);
+			for (;;) {
+				slot = &slots[pos & (Capacity - 1)];
+				size_t seq = slot->sequence.load(std::memory_order_acquire);
+				intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+				if (diff == 0) {
+					if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+				}
+				else if (diff < 0) {
+					return std::nullopt;
+				}
+				else {
+					pos = dequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+			T* stored = std::launder(reinterpret_cast<T*>(&slot->storage));
+			std::optional<T> result(std::move(*stored));
+			stored->~T();
+			slot->sequence.store(pos + Capacity, std::memory_order_release);
+			return result;
+		}
+
+		bool tryPush(T& value) {
+			Slot* slot;
+			size_t pos = enqueuePos.load(std::memory_order_relaxed);
+			for (;;) {
+				slot = &slots[pos & (Capacity - 1)];
+				size_t seq = slot->sequence.load(std::memory_order_acquire);
+				intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+				if (diff == 0) {
+					if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+				}
+				else if (diff < 0) {
+					return false;
+				}
+				else {
+					pos = enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+			new (&slot->storage) T(std::move(value));
+			slot->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		void updateHighWaterMark() {
+			size_t current = size();
+			size_t known = highWaterMark.load(std::memory_order_relaxed);
+			while (current > known && !highWaterMark.compare_exchange_weak(known, current, std::memory_order_relaxed)) {}
+		}
+
+		static constexpr size_t cacheLineSize = 64;
+
+		std::array<Slot, Capacity> slots;
+		alignas(cacheLineSize) std::atomic<size_t> enqueuePos = 0;
+		alignas(cacheLineSize) std::atomic<size_t> dequeuePos = 0;
+		alignas(cacheLineSize) std::atomic<uint64_t> pushedCount = 0;
+		std::atomic<uint64_t> poppedCount = 0;
+		std::atomic<uint64_t> droppedCount = 0;
+		std::atomic<size_t> highWaterMark = 0;
+		std::atomic<RingOverflowPolicy> overflowPolicy;
+	};
+}
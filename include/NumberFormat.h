@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace GW2_SCT {
+	// Separators used when writing numbers, a '\0' group separator disables digit grouping
+	struct NumberFormat {
+		char decimalSeparator = '.';
+		char groupSeparator = '\0';
+		bool operator==(const NumberFormat& other) const = default;
+	};
+
+	// Fits any int64 with grouping and any shortened value up to the trillions
+	constexpr size_t NumberBufferSize = 48;
+	using NumberBuffer = char[NumberBufferSize];
+
+	// Allocation free version of ShortenNumber, the returned view points into buffer. Precision -1 writes
+	// the rounded whole number, 0 to 3 the decimals kept in the k/M/B/T form. Values too long for the
+	// buffer are written in scientific notation.
+	std::string_view FormatNumber(NumberBuffer& buffer, double number, int precision, NumberFormat format = {});
+	// Writes a whole number, grouped if the format asks for it
+	std::string_view FormatInteger(NumberBuffer& buffer, int64_t number, NumberFormat format = {});
+}
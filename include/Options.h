@@ -3,17 +3,62 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <array>
+#include <atomic>
+#include <memory>
 #include "UtilStructures.h"
 #include "OptionsStructures.h"
+#include "EventRecord.h"
 
 namespace GW2_SCT {
 	class ScrollArea;
 
 	std::map<char, std::string> mapParameterListToLanguage(const char* section, std::vector<char> list);
 
+	// Plain copy of the profile settings that are read per message or per frame on the UI thread,
+	// republished by it once per frame, see Options::hot.
+	struct HotOptions {
+		using Color = std::array<char, 16>;
+
+		bool sctEnabled = true;
+		bool selfMessageOnlyIncoming = false;
+		bool outgoingOnlyToTarget = false;
+		bool coalesceIngestedEvents = false;
+		OverloadMode overloadMode = OverloadMode::OFF;
+		int overloadQueueDepth = 30;
+		float overloadFrameBudgetMs = 2.f;
+		NumberFormat numberFormat;
+		bool combineAllMessages = true;
+		bool dropShadow = true;
+		bool skillIconsEnabled = true;
+		int messagesInStack = 3;
+		float scrollSpeed = 90.f;
+		float globalOpacity = 1.0f;
+		float defaultFontSize = 22.f;
+		float defaultCritFontSize = 30.f;
+		bool globalThresholdsEnabled = false;
+		bool globalThresholdRespectFilters = true;
+		int globalDamageThreshold = 0;
+		int globalHealThreshold = 0;
+		int globalAbsorbThreshold = 0;
+		std::array<Color, PROFESSION_REVENANT + 1> professionColors = {}; // indexed by profession, PROFESSION_UNDEFINED holds the default color
+
+		bool operator==(const HotOptions& other) const = default;
+		const char* professionColor(uint32_t prof) const { return professionColors[prof < professionColors.size() ? prof : static_cast<uint32_t>(PROFESSION_UNDEFINED)].data(); }
+	};
+
 	class Options {
 	public:
 		static const std::shared_ptr<profile_options_struct> get();
+		// Current profile's hot settings for the UI thread, which is the only one replacing them
+		static const HotOptions& hot() { return uiHotOptions; }
+		// The settings of any thread's combat callback, packed into one word so reading them neither locks nor counts references
+		static CombatHotOptions combatHot() {
+			uint32_t bits = combatHotBits.load(std::memory_order_relaxed);
+			return { (bits & COMBAT_SELF_MESSAGE_ONLY_INCOMING) != 0, (bits & COMBAT_OUTGOING_ONLY_TO_TARGET) != 0 };
+		}
+		// Republishes the settings if the current profile differs from them, called once per frame on the UI thread
+		static void publishHotOptions();
 		// Access to options struct for Profiles class
 		static options_struct& getOptionsStruct() { return options; }
 		static void paint(const std::vector<std::shared_ptr<ScrollArea>>& scrollAreas);
@@ -36,6 +81,10 @@ namespace GW2_SCT {
 		static void paintGlobalThresholds();
 		static void paintSkillIcons();
 		static options_struct options;
+		static HotOptions uiHotOptions;
+		static constexpr uint32_t COMBAT_SELF_MESSAGE_ONLY_INCOMING = 1 << 0;
+		static constexpr uint32_t COMBAT_OUTGOING_ONLY_TO_TARGET = 1 << 1;
+		static std::atomic<uint32_t> combatHotBits;
 		static bool windowIsOpen;
 		static std::string fontSelectionString;
 		static std::string fontSizeTypeSelectionString;
@@ -5,6 +5,7 @@
 #include "Common.h"
 #include "UtilStructures.h"
 #include "SkillFilterStructures.h"
+#include "NumberFormat.h"
 
 
 namespace GW2_SCT {
@@ -35,10 +36,31 @@ namespace GW2_SCT {
 	extern int skillIconDisplayTypeToInt(SkillIconDisplayType type);
 	extern SkillIconDisplayType intSkillIconDisplayType(int i);
 
+	enum class OverloadMode {
+		OFF = 0,
+		DROP_LOWEST_VALUE,
+		DROP_OLDEST,
+		COLLAPSE
+	};
+	extern int overloadModeToInt(OverloadMode mode);
+	extern OverloadMode intToOverloadMode(int i);
+
+	enum class NumberFormatStyle {
+		PLAIN = 0,     // 1234567.8
+		COMMA_GROUPED, // 1,234,567.8
+		DOT_GROUPED,   // 1.234.567,8
+		SPACE_GROUPED, // 1 234 567,8
+		DECIMAL_COMMA  // 1234567,8
+	};
+	extern int numberFormatStyleToInt(NumberFormatStyle style);
+	extern NumberFormatStyle intToNumberFormatStyle(int i);
+	extern NumberFormat numberFormatOf(NumberFormatStyle style);
+
 	class profile_options_struct;
 	class scroll_area_options_struct;
 	class message_receiver_options_struct;
 	class EventMessage;
+	struct CompiledTemplate;
 
 	class options_struct {
 	public:
@@ -69,6 +91,11 @@ namespace GW2_SCT {
 		float defaultCritFontSize = 30.f;
 		bool selfMessageOnlyIncoming = false;
 		bool outgoingOnlyToTarget = false;
+		bool coalesceIngestedEvents = false;
+		OverloadMode overloadMode = OverloadMode::OFF;
+		int overloadQueueDepth = 30;
+		float overloadFrameBudgetMs = 2.f;
+		NumberFormatStyle numberFormatStyle = NumberFormatStyle::PLAIN;
 		std::string professionColorGuardian = "72C1D9";
 		std::string professionColorWarrior = "FFD166";
 		std::string professionColorEngineer = "D09C59";
@@ -127,6 +154,8 @@ namespace GW2_SCT {
 		bool abbreviateSkillNames = false;
 		int  shortenNumbersPrecision = -1;
 		bool disableCombining = false;
+		// Hits merge into messages that started being displayed at most this long ago, 0 disables
+		int combineWindowMs = 0;
 		float customScrollSpeed = -1.0f;
 		bool mergeCritWithHit = false;
 		
@@ -164,66 +193,27 @@ namespace GW2_SCT {
 		int absorbThreshold = 0;
 		bool thresholdRespectFilters = true;
 
-		// TODO: relocate this
-		bool isSkillFiltered(uint32_t skillId, const std::string& skillName, const SkillFilterManager& filterManager) const {
-			if (!filtersEnabled || assignedFilterSets.empty()) {
-				return false;
-			}
-
-			std::vector<std::pair<FilterAction, int>> matchingFilters;
-			FilterAction combinedDefaultAction = FilterAction::ALLOW;
-
-			for (const std::string& filterSetName : assignedFilterSets) {
-				auto filterSet = filterManager.getFilterSet(filterSetName);
-				if (!filterSet) continue;
-
-				if (filterSet->filterSet.defaultAction == FilterAction::BLOCK) {
-					combinedDefaultAction = FilterAction::BLOCK;
-				}
-
-				for (const auto& filter : filterSet->filterSet.filters) {
-					if (filter.matches(skillId, skillName)) {
-						matchingFilters.push_back({ filter.action, filter.getSpecificityScore() });
-					}
-				}
-			}
-
-			if (matchingFilters.empty()) {
-				return combinedDefaultAction == FilterAction::BLOCK;
-			}
-
-			FilterAction finalAction = combinedDefaultAction;
-			int highestSpecificity = -1;
-			bool hasAllow = false;
-			bool hasBlock = false;
-
-			for (const auto& filterPair : matchingFilters) {
-				if (filterPair.second > highestSpecificity) {
-					highestSpecificity = filterPair.second;
-				}
-			}
-
-			for (const auto& filterPair : matchingFilters) {
-				if (filterPair.second == highestSpecificity) {
-					if (filterPair.first == FilterAction::ALLOW) hasAllow = true;
-					if (filterPair.first == FilterAction::BLOCK) hasBlock = true;
-				}
-			}
-
-			if (hasAllow && hasBlock) {
-				finalAction = FilterAction::ALLOW;  // ALLOW wins conflicts
-			}
-			else if (hasAllow) {
-				finalAction = FilterAction::ALLOW;
-			}
-			else if (hasBlock) {
-				finalAction = FilterAction::BLOCK;
-			}
-
-			return finalAction == FilterAction::BLOCK;
+		bool isSkillFiltered(uint32_t skillId, InternedString skillName, const SkillFilterManager& filterManager) const;
+		// assignedFilterSets compiled, and the verdicts given since, at the filter manager generation below
+		mutable CompiledSkillFilter transient_compiledFilter = {};
+		mutable SkillFilterVerdictCache transient_filterVerdicts = {};
+		mutable uint64_t transient_compiledFilterGeneration = 0;
+
+		// Changes whenever outputTemplate, color, font or fontSize is assigned, so displayed messages can notice they are outdated
+		uint64_t getRenderGeneration() const {
+			return outputTemplate.getGeneration() + color.getGeneration() + font.getGeneration() + fontSize.getGeneration();
 		}
 
-		bool isThresholdExceeded(std::shared_ptr<EventMessage> message, uint32_t skillId, const std::string& skillName, const SkillFilterManager& filterManager) const;
+		bool isThresholdExceeded(const EventMessage& message, uint32_t skillId, InternedString skillName, const SkillFilterManager& filterManager) const;
+
+		// outputTemplate and color compiled for messages of the given category and type, recompiled
+		// only after one of them was assigned or a message of another category or type asks for it
+		std::shared_ptr<const CompiledTemplate> getCompiledTemplate(MessageCategory messageCategory, MessageType messageType);
+		std::shared_ptr<const CompiledTemplate> transient_compiledTemplate = nullptr;
+		uint64_t transient_compiledTemplateGeneration = 0;
+		uint64_t transient_compiledColorGeneration = 0;
+		MessageCategory transient_compiledCategory = MessageCategory::PLAYER_OUT;
+		MessageType transient_compiledType = MessageType::NONE;
 		
 	private:
 		enum class ThresholdCategory {
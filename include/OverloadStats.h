@@ -0,0 +1,34 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace GW2_SCT {
+	struct OverloadCounters {
+		uint64_t droppedMessages = 0;   // pending scroll area messages dropped by the overload mode
+		uint64_t collapsedMessages = 0; // pending scroll area messages folded into a "+N more" line
+		uint64_t deferredFrames = 0;    // frames that stopped draining events at the frame budget
+		uint64_t ingestDropped = 0;     // events evicted from the full ingest queue
+	};
+
+	// Process-wide load shedding counters, written by the UI and arcdps threads, shown in the options.
+	class OverloadStats {
+	public:
+		static void addDropped(uint64_t n = 1) { droppedMessages.fetch_add(n, std::memory_order_relaxed); }
+		static void addCollapsed(uint64_t n = 1) { collapsedMessages.fetch_add(n, std::memory_order_relaxed); }
+		static void addDeferredFrame() { deferredFrames.fetch_add(1, std::memory_order_relaxed); }
+		static void setIngestDropped(uint64_t n) { ingestDropped.store(n, std::memory_order_relaxed); }
+		static OverloadCounters get() {
+			OverloadCounters counters;
+			counters.droppedMessages = droppedMessages.load(std::memory_order_relaxed);
+			counters.collapsedMessages = collapsedMessages.load(std::memory_order_relaxed);
+			counters.deferredFrames = deferredFrames.load(std::memory_order_relaxed);
+			counters.ingestDropped = ingestDropped.load(std::memory_order_relaxed);
+			return counters;
+		}
+	private:
+		static inline std::atomic<uint64_t> droppedMessages = 0;
+		static inline std::atomic<uint64_t> collapsedMessages = 0;
+		static inline std::atomic<uint64_t> deferredFrames = 0;
+		static inline std::atomic<uint64_t> ingestDropped = 0;
+	};
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "imgui.h"
+#include "FontManager.h"
+
+namespace GW2_SCT {
+	// Stacking order of the quads of one scroll area, each layer is drawn completely before the next one
+	enum class QuadLayer : uint8_t {
+		SHADOW,
+		TEXT,
+		ICON
+	};
+
+	struct DrawCounters {
+		uint32_t quads = 0;           // glyphs and icons painted, fully transparent ones are skipped
+		uint32_t textureSwitches = 0; // texture changes in the order the quads were painted, the draw commands one AddImage per quad needed
+		uint32_t drawCommands = 0;    // layer and texture groups the quads were written to the draw list with
+	};
+
+	// Collects the glyph and icon quads of a scroll area and writes them to the foreground draw list
+	// grouped by layer and texture: all drop shadows first, then the text of each atlas page, then the
+	// icons. Text therefore always stacks above every shadow of its area, and areas painted later stay
+	// on top of earlier ones because each area is flushed on its own.
+	class QuadBatch {
+	public:
+		static void add(QuadLayer layer, Texture* texture, ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color);
+		static void addLayout(QuadLayer layer, const std::vector<FontType::GlyphQuad>& quads, ImVec2 pos, ImU32 color);
+		// Writes the quads added since the last flush, called after each scroll area
+		static void flush();
+		static void endFrame();
+		static DrawCounters lastFrame() { return lastFrameCounters; }
+	private:
+		struct Quad {
+			ImVec2 min, max;
+			ImVec2 uvStart, uvEnd;
+			ImU32 color;
+		};
+		struct Group {
+			QuadLayer layer = QuadLayer::TEXT;
+			Texture* texture = nullptr;
+			std::vector<Quad> quads;
+			bool usedThisFrame = false;
+		};
+		static Group& groupFor(QuadLayer layer, Texture* texture);
+
+		// Groups and their quad storage stay allocated across frames, a group is only dropped after a
+		// frame without quads so that it never outlives its texture for long
+		static inline std::vector<Group> groups;
+		static inline size_t lastGroup = 0;
+		static inline Texture* lastAddedTexture = nullptr;
+		static inline DrawCounters frameCounters;
+		static inline DrawCounters lastFrameCounters;
+	};
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <vector>
 #include <thread>
@@ -7,6 +8,9 @@
 #include "Common.h"
 #include "Options.h"
 #include "ScrollArea.h"
+#include "Message.h"
+#include "EventRecord.h"
+#include "SkillRemapTable.h"
 
 /* arcdps export table */
 struct arcdps_exports {
@@ -37,16 +41,20 @@ namespace GW2_SCT {
 		uintptr_t CombatEventLocal(cbtevent* ev, ag* src, ag* dst, char* skillname, uint64_t id, uint64_t revision);
 		uintptr_t UIUpdate();
 		uintptr_t UIOptions();
-		void sendMessageToEmission(std::shared_ptr<EventMessage> m);
+		void sendMessageToEmission(const EventRecord& record);
 	private:
 		void resetScrollAreas(std::shared_ptr<profile_options_struct> profile);
+		void routeEvent(const EventRecord& record);
 		uint32_t remapSkillID(uint32_t originalID);
 		arcdps_exports arc_exports;
 
-		uintptr_t selfInstID = -1;
-		uintptr_t targetAgentId = -1;
-		std::map<uint32_t, uint32_t> skillRemaps;
+		EventIngestState ingestState;
+		SkillRemapTable skillRemaps;
 		std::vector<std::shared_ptr<GW2_SCT::ScrollArea>> scrollAreas;
+		// Scroll areas with a receiver per category and type, rebuilt when ScrollArea::getRoutingGeneration moves on
+		std::array<std::array<std::vector<std::shared_ptr<GW2_SCT::ScrollArea>>, NUM_MESSAGE_TYPES>, NUM_CATEGORIES> scrollAreaRoutes;
+		uint64_t scrollAreaRoutesGeneration = 0;
+		void ensureScrollAreaRoutes();
 
 		long currentScrollAreaEraseCallbackId = -1;
 		long currentScrollAreaPushBackCallbackId = -1;
@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <chrono>
@@ -6,6 +8,7 @@
 #include <mutex>
 #include <limits>
 #include "OptionsStructures.h"
+#include "CombineQueue.h"
 #include "Message.h"
 #include "TemplateInterpreter.h"
 
@@ -13,10 +16,38 @@ namespace GW2_SCT {
 	class ScrollArea {
 	public:
 		ScrollArea(std::shared_ptr<scroll_area_options_struct> options);
-		void receiveMessage(std::shared_ptr<EventMessage> m);
+		~ScrollArea();
+		void receiveMessage(const RoutedMessage& m);
 		void paint();
 		std::shared_ptr<scroll_area_options_struct> getOptions() { return options; }
+		// Whether a message of this category and type reaches an enabled receiver of this scroll area
+		bool acceptsMessage(MessageCategory category, MessageType type);
+
+		// Outdates the receiver routing of every scroll area, for edits that change which receivers take which messages
+		static void invalidateRouting() { routingGeneration.fetch_add(1, std::memory_order_relaxed); }
+		static uint64_t getRoutingGeneration() { return routingGeneration.load(std::memory_order_relaxed); }
 	private:
+		// Enabled receivers per incoming category and type, crits already folded into hits when the area merges them
+		using ReceiverList = std::vector<std::shared_ptr<message_receiver_options_struct>>;
+		std::array<std::array<ReceiverList, NUM_MESSAGE_TYPES>, NUM_CATEGORIES> receiverRoutes;
+		uint64_t receiverRoutesGeneration = 0;
+		long receiverPushBackCallbackId = -1;
+		long receiverEraseCallbackId = -1;
+		void ensureReceiverRoutes();
+		static inline std::atomic<uint64_t> routingGeneration = 1;
+
+		// Messages a new one may be combined into: same receiver and skill, and for incoming messages same source
+		struct CombineKey {
+			const message_receiver_options_struct* receiver = nullptr;
+			uint32_t skillId = 0;
+			uint64_t entityId = 0;
+			bool operator==(const CombineKey& other) const = default;
+		};
+		struct CombineKeyHash {
+			size_t operator()(const CombineKey& key) const;
+		};
+		static CombineKey combineKeyOf(const message_receiver_options_struct* receiver, MessageCategory category, const MessageData& data);
+
 		struct MessagePrerender {
 			std::shared_ptr<EventMessage> message;
 			std::string str;
@@ -26,9 +57,10 @@ namespace GW2_SCT {
 			MessageType type;
 			std::shared_ptr<message_receiver_options_struct> options;
 			std::vector<TemplateInterpreter::InterpretedText> interpretedText;
-			float interpretedTextWidth;
+			float interpretedTextWidth = 0.f;
 			bool prerenderNeeded = true;
-			long templateObserverId, colorObserverId, fontObserverId, fontSizeObserverId;
+			// Receiver render generation str and the layout were made for, see getRenderGeneration
+			uint64_t renderGeneration = 0;
 			
 			float liveOffsetMs = 0.0f;
 			// One-shot vertical offset applied at spawn to guarantee min spacing
@@ -43,18 +75,24 @@ namespace GW2_SCT {
 			// Angled animation fields
 			int angledSign = 0;
 			float angledAngleRad = 0.0f;
+
+			CombineKey combineKey;
 		public:
 			MessagePrerender(std::shared_ptr<EventMessage> message, std::shared_ptr<message_receiver_options_struct> options);
-			MessagePrerender(const MessagePrerender& copy);
-			~MessagePrerender();
 			void update();
 			void prerenderText();
 			void ensureExtents();
 		};
 
 		std::mutex messageQueueMutex;
-		std::deque<MessagePrerender> messageQueue = std::deque<MessagePrerender>();
+		using MessageQueue = CombineQueue<MessagePrerender, CombineKey, CombineKeyHash>;
+		MessageQueue messageQueue;
 
+		// Bounds messageQueue according to the overload mode, caller holds messageQueueMutex
+		void shedOverload();
+		// Merges into a displayed message younger than the scroll area's combine window, caller holds messageQueueMutex
+		bool combineWithPainted(const CombineKey& key, MessageCategory category, MessageType type, const std::shared_ptr<const MessageData>& messageData);
+		void paintCollapsedSummary(std::chrono::time_point<std::chrono::steady_clock> frameNow);
 		bool paintMessage(MessagePrerender& m, __int64 time, float globalSpeedMultiplier);
 		float getEffectiveScrollSpeed() const;
 		void applySimpleSpacing(float globalSpeedMultiplier, double dt, std::chrono::time_point<std::chrono::steady_clock> frameNow);
@@ -65,6 +103,10 @@ namespace GW2_SCT {
 		std::chrono::time_point<std::chrono::steady_clock> lastPaintTs = {};
 		
 		int angledMessageCounter = 0;
+
+		// Messages folded into the "+N more" line, cleared once no more overflow happened for a while
+		uint64_t collapsedMessages = 0;
+		std::chrono::time_point<std::chrono::steady_clock> lastCollapseTs = {};
 		
 		// Smooth speed multiplier for less jarring transitions
 		float currentSpeedMultiplier = 1.0f;
@@ -3,9 +3,16 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 #include <memory>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include "json.hpp"
+#include "StringInterner.h"
 
 namespace nlohmann {
     template <typename T>
@@ -62,7 +69,7 @@ namespace GW2_SCT {
             return 0;
         }
 
-        bool matches(uint32_t skillId, const std::string& skillName) const {
+        bool matches(uint32_t skillId, std::string_view skillName) const {
             switch (type) {
             case FilterType::SKILL_ID:
                 return this->skillId == skillId;
@@ -80,7 +87,7 @@ namespace GW2_SCT {
         FilterAction defaultAction = FilterAction::ALLOW;
         std::vector<SkillFilter> filters;
 
-        bool isFiltered(uint32_t skillId, const std::string& skillName) const {
+        bool isFiltered(uint32_t skillId, std::string_view skillName) const {
             const SkillFilter* bestMatch = nullptr;
             int highestSpecificity = -1;
 
@@ -112,11 +119,15 @@ namespace GW2_SCT {
     class SkillFilterManager {
     private:
         std::map<std::string, std::shared_ptr<NamedSkillFilterSet>> filterSets;
+        // Unique over all managers, so switching to another profile's filters is noticed as well
+        static inline std::atomic<uint64_t> lastGeneration = 0;
+        uint64_t generation = ++lastGeneration;
 
     public:
         void addFilterSet(std::shared_ptr<NamedSkillFilterSet> filterSet) {
             if (filterSet) {
                 filterSets[filterSet->name] = filterSet;
+                markChanged();
             }
         }
 
@@ -124,6 +135,7 @@ namespace GW2_SCT {
             auto filterSet = std::make_shared<NamedSkillFilterSet>();
             filterSet->name = name;
             filterSets[name] = filterSet;
+            markChanged();
             return filterSet;
         }
 
@@ -131,11 +143,16 @@ namespace GW2_SCT {
             auto it = filterSets.find(name);
             if (it != filterSets.end()) {
                 filterSets.erase(it);
+                markChanged();
                 return true;
             }
             return false;
         }
 
+        // Has to be called after a filter set or a receiver's filter assignment was edited in place
+        void markChanged() { generation = ++lastGeneration; }
+        uint64_t getGeneration() const { return generation; }
+
         std::shared_ptr<NamedSkillFilterSet> getFilterSet(const std::string& name) const {
             auto it = filterSets.find(name);
             return (it != filterSets.end()) ? it->second : nullptr;
@@ -146,6 +163,65 @@ namespace GW2_SCT {
         }
     };
 
+    // The filter sets assigned to a receiver folded into lookup tables, one per filter type in order of specificity.
+    // Gives the same verdict as matching every filter: the most specific matching filters decide, ALLOW winning ties.
+    class CompiledSkillFilter {
+    public:
+        void compile(const std::vector<std::string>& filterSetNames, const SkillFilterManager& filterManager);
+        bool isFiltered(uint32_t skillId, std::string_view skillName) const;
+
+    private:
+        enum : uint8_t {
+            ALLOWS = 1 << 0,
+            BLOCKS = 1 << 1
+        };
+        struct IdRun {
+            uint32_t start;
+            uint32_t end;
+            uint8_t actions;
+        };
+        struct NameHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        std::unordered_map<uint32_t, uint8_t> ids;
+        std::unordered_map<std::string, uint8_t, NameHash, std::equal_to<>> names;
+        // Disjoint and sorted, every id range filter split up where it overlaps others
+        std::vector<IdRun> ranges;
+        bool defaultBlocks = false;
+    };
+
+    struct SkillFilterCacheStats {
+        uint64_t lookups = 0;
+        uint64_t hits = 0;
+    };
+
+    // Filter verdicts of recently seen skills, direct mapped by skill id. Names are compared by
+    // their interned handle. Has to be cleared whenever the verdicts could have changed.
+    class SkillFilterVerdictCache {
+    public:
+        bool find(uint32_t skillId, InternedString skillName, bool& filtered) const;
+        void store(uint32_t skillId, InternedString skillName, bool filtered);
+        void clear() { entries = {}; }
+        // Summed over the caches of all receivers
+        static SkillFilterCacheStats getStats();
+
+    private:
+        struct Entry {
+            uint32_t skillId = 0;
+            InternedString skillName = 0;
+            bool filtered = false;
+            bool used = false;
+        };
+        static constexpr size_t SIZE = 64;
+        static size_t slotOf(uint32_t skillId) { return (skillId * 2654435761u) >> 26; }
+
+        std::array<Entry, SIZE> entries{};
+        static inline std::atomic<uint64_t> lookups = 0;
+        static inline std::atomic<uint64_t> hits = 0;
+    };
+
     void to_json(nlohmann::json& j, const FilterAction& action);
     void from_json(const nlohmann::json& j, FilterAction& action);
     void to_json(nlohmann::json& j, const SkillIdRange& range);
@@ -14,6 +14,8 @@ namespace GW2_SCT {
 	class SkillIcon {
 	public:
 		ImVec2 draw(ImVec2 pos, ImVec2 size, ImU32 color = 0xFFFFFFFF);
+		// Texture for the configured display type, nullptr until its creation went through
+		Texture* getTexture();
 		SkillIcon(std::shared_ptr<std::vector<BYTE>> fileData, uint32_t skillID);
 		~SkillIcon();
 
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace GW2_SCT {
+	struct SkillRemapDiagnostics {
+		size_t entries = 0;      // ids that are remapped after compilation
+		size_t chains = 0;       // entries that had to follow more than one hop
+		size_t longestChain = 0;
+		size_t cycles = 0;       // entries dropped because their chain loops
+		size_t selfMaps = 0;     // entries mapping an id to itself, ignored
+	};
+
+	// Flattened skill id remapping. Chains (a -> b -> c) are resolved when compiling, so a lookup
+	// is a single bounds check and array read over the dense id range covered by the remaps.
+	class SkillRemapTable {
+	public:
+		// Compiles the raw from -> to pairs, logging every chain and cycle it finds.
+		SkillRemapDiagnostics compile(const std::map<uint32_t, uint32_t>& remaps);
+		uint32_t remap(uint32_t id) const {
+			uint32_t index = id - firstId;
+			if (index < dense.size()) return dense[index];
+			if (!sparse.empty()) return remapSparse(id);
+			return id;
+		}
+		size_t size() const { return entries; }
+	private:
+		// Ids further than this from the lowest remapped id are kept in a sorted list instead
+		static constexpr uint32_t maxDenseSpan = 1u << 20;
+		uint32_t remapSparse(uint32_t id) const;
+
+		uint32_t firstId = 0;
+		std::vector<uint32_t> dense;
+		std::vector<std::pair<uint32_t, uint32_t>> sparse;
+		size_t entries = 0;
+	};
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace GW2_SCT {
+	// Handle of a string owned by StringInterner. 0 is reserved for "no string".
+	// Equal strings always share a handle, so handles can be compared instead of the strings.
+	using InternedString = uint32_t;
+
+	struct StringInternerStats {
+		size_t strings = 0;
+		size_t stringBytes = 0;
+		size_t tableBytes = 0; // approximate bookkeeping overhead (entries, lookup and id tables)
+		uint64_t lookups = 0;
+		uint64_t hits = 0;      // lookups that returned an existing handle
+		uint64_t keyedHits = 0; // hits resolved by skill/agent id without hashing the name
+	};
+
+	// Names of one combat event, 0 where arcdps gave none
+	struct EventNames {
+		InternedString skillName = 0;
+		InternedString srcName = 0;
+		InternedString dstName = 0;
+	};
+
+	// Process-wide table of immutable strings (skill and agent names). Interned strings are never
+	// freed or moved, so handles and the pointers returned for them stay valid until unload.
+	// Interning a new string is serialized between producers, resolving a handle never locks.
+	class StringInterner {
+	public:
+		static InternedString intern(const char* str);
+		static InternedString intern(std::string_view str);
+		// Fast path for the names arcdps hands out per id. Names already seen for their id are
+		// resolved without locking, the lock is taken once per call only if any of the three missed.
+		// The id only short-cuts the lookup, a changed name for a known id is interned normally.
+		static EventNames internEventNames(uint32_t skillId, const char* skillName, uint64_t srcId, const char* srcName, uint64_t dstId, const char* dstName);
+		// Pre-allocates entries, lookup table and text storage so that interning up to that many
+		// new strings does not allocate
+		static void reserve(size_t strings, size_t textBytes);
+		static std::string_view view(InternedString handle);
+		// nullptr for the empty handle, otherwise a null-terminated string
+		static const char* c_str(InternedString handle);
+		static size_t size();
+		static StringInternerStats getStats();
+	};
+}
@@ -17,10 +17,12 @@ namespace GW2_SCT {
 			ImVec2 size;
 			ImU32 color;
 			SkillIcon* icon;
+			// Glyphs of str relative to offset, laid out once so painting only translates them
+			std::vector<FontType::GlyphQuad> glyphs;
 			InterpretedText(std::string str, ImVec2 size, ImVec2 offset, ImU32 color, SkillIcon* icon = nullptr)
 				: str(str), size(size), offset(offset), color(color), icon(icon) {}
 		};
-		static bool validate(std::string, std::map<char, std::string>);
-		static std::vector<InterpretedText> interpret(GW2_SCT::FontType* font, float fontSize, ImU32 defaultColor, std::string t);
+		static bool validate(const std::string& t, const std::map<char, std::string>& params);
+		static std::vector<InterpretedText> interpret(GW2_SCT::FontType* font, float fontSize, ImU32 defaultColor, const std::string& t);
 	};
 }
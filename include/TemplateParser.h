@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GW2_SCT {
+	// Which markup is parsed: a receiver's output template, where %x inserts parameter x, or the text
+	// rendered from it, where % has no meaning
+	enum class TemplateSyntax {
+		TEMPLATE,
+		RENDERED
+	};
+
+	enum class TemplateError {
+		NONE = 0,
+		LONE_CLOSING_BRACKET, // "]" that is not written as "]]"
+		UNTERMINATED_TAG,     // "[" without the "]" ending the tag
+		UNKNOWN_TAG,
+		MISSING_TAG_VALUE,    // "[col]" or "[icon]" without "="
+		INVALID_COLOR,
+		INVALID_ICON,
+		UNEXPECTED_CLOSING_TAG,
+		UNCLOSED_TAG,
+		UNKNOWN_PARAMETER
+	};
+
+	struct TemplateNode {
+		enum class Type : uint8_t {
+			TEXT,        // text, with "[[", "]]" and "%%" already unescaped
+			PARAMETER,   // %x
+			COLOR_BEGIN, // [col=RRGGBB], or [col=%x] in a template
+			COLOR_END,
+			ICON_BEGIN,  // [icon=ID]
+			ICON_END
+		};
+		Type type;
+		size_t position = 0;   // offset of the node in the parsed source
+		std::string_view text; // TEXT: the text, COLOR_BEGIN and ICON_BEGIN: the raw tag value
+		char parameter = 0;    // PARAMETER, or COLOR_BEGIN taking its color from a parameter
+		int rgb = 0;           // COLOR_BEGIN
+		uint32_t iconId = 0;   // ICON_BEGIN, 0 if the id does not fit a skill id
+	};
+
+	// The nodes view into the parsed source, which has to outlive them
+	struct TemplateParseResult {
+		std::vector<TemplateNode> nodes;
+		TemplateError error = TemplateError::NONE;
+		size_t errorPosition = 0;
+		bool valid() const { return error == TemplateError::NONE; }
+	};
+
+	// Single parser for output templates and rendered message markup, used by validation in the options,
+	// template compilation and the text interpreter.
+	class TemplateParser {
+	public:
+		// parameters restricts the %x accepted in templates, nullptr accepts any. result is cleared first,
+		// passing the same one again reuses its storage.
+		static void parse(std::string_view source, TemplateSyntax syntax, const std::map<char, std::string>* parameters, TemplateParseResult& result);
+		static TemplateParseResult parse(std::string_view source, TemplateSyntax syntax, const std::map<char, std::string>* parameters = nullptr);
+		// Human readable "column: reason" description of a failed parse
+		static std::string describeError(const TemplateParseResult& result);
+	};
+}
@@ -10,7 +10,10 @@ namespace GW2_SCT {
         Texture(int width, int height);
         void draw(ImVec2 pos, ImVec2 size, ImU32 color);
         void draw(ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color);
+        // Id to submit own draw list vertices with, nullptr while the texture is not created yet
+        ImTextureID prepareDraw();
         virtual void internalDraw(ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color) = 0;
+        virtual ImTextureID internalPrepareDraw() = 0;
         virtual bool internalCreate() = 0;
         void ensureCreation();
         bool isReady() const { return _created; }
@@ -82,6 +85,7 @@ namespace GW2_SCT {
         ImmutableTextureD3D11(int width, int height, unsigned char* data);
     protected:
         void internalDraw(ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color) override;
+        ImTextureID internalPrepareDraw() override;
         bool internalCreate() override;
     };
 
@@ -91,6 +95,7 @@ namespace GW2_SCT {
         ~MutableTextureD3D11();
     protected:
         void internalDraw(ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color) override;
+        ImTextureID internalPrepareDraw() override;
         bool internalCreate() override;
         bool internalStartUpdate(ImVec2 pos, ImVec2 size, UpdateData* out) override;
         bool internalEndUpdate() override;
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <functional>
@@ -71,10 +72,14 @@ public:
     ObservableValue& operator=(const ObservableValue& other) {
         T oldValue = value;
         value = other.value;
+        generation++;
         for (auto& callback : onAssignCallbacks) callback.second(oldValue, other.value);
         return *this;
     }
 
+    // Incremented on every assignment, lets readers cache something derived from the value
+    uint64_t getGeneration() const { return generation; }
+
     long onAssign(std::function<void(const T&, const T&)> callback) {
         onAssignCallbacks.insert(std::pair<long, std::function<void(const T&, const T&)>>(nextAssignCallbackIndex, callback));
         nextAssignCallbackIndex++;
@@ -121,6 +126,7 @@ public:
 
 private:
     T value;
+    uint64_t generation = 0;
     std::map<long, std::function<void(const T&, const T&)>> onAssignCallbacks = {};
     long nextAssignCallbackIndex = 0;
 };
@@ -2,7 +2,8 @@
 #include "OptionsStructures.h"
 
 enum ReceiverCollapsibleChangeFlags {
-	ReceiverCollapsible_Remove = 1 << 0
+	ReceiverCollapsible_Remove = 1 << 0,
+	ReceiverCollapsible_Rerouted = 1 << 1
 };
 
 enum FilterIDOptionLineChangeFlags {
@@ -1,5 +1,6 @@
 #include "Common.h"
 #include "Language.h"
+#include "NumberFormat.h"
 #include <fstream>
 #include <filesystem>
 
@@ -129,75 +130,7 @@ bool floatEqual(float a, float b) {
 	return (diff < std::numeric_limits<float>::epsilon()) && (-diff < std::numeric_limits<float>::epsilon());
 }
 
-std::string AbbreviateSkillName(const std::string& skillName) {
-	if (skillName.find_first_of(" -") == std::string::npos) {
-		return skillName;
-	}
-
-	std::string result;
-	bool nextIsFirst = true;
-
-	for (char c : skillName) {
-		if (std::isalpha(c)) {
-			if (nextIsFirst) {
-				result += c;
-				nextIsFirst = false;
-			}
-		}
-		else if (c == ' ' || c == '-') {
-			nextIsFirst = true;
-		}
-	}
-
-	return result;
-}
-
 std::string ShortenNumber(double number, int precision) {
-	if (std::isnan(number) || std::isinf(number) || number < 0) {
-		return "0";
-	}
-	if (precision == -1) {
-		return std::to_string(static_cast<long long>(std::round(number)));
-	}
-
-	precision = std::max(0, std::min(3, precision));
-
-	auto cleanDecimal = [](std::string str) -> std::string {
-		if (str.find('.') != std::string::npos) {
-			str.erase(str.find_last_not_of('0') + 1);
-			if (str.back() == '.') {
-				str.pop_back();
-			}
-		}
-		return str;
-		};
-
-	auto formatValue = [&cleanDecimal](double value, const std::string& suffix, int prec) -> std::string {
-		std::ostringstream oss;
-		oss << std::fixed << std::setprecision(prec) << value;
-		return cleanDecimal(oss.str()) + suffix;
-		};
-
-	if (number >= 1e12) {
-		return formatValue(number / 1e12, "T", precision);
-	}
-	else if (number >= 1e9) {
-		return formatValue(number / 1e9, "B", precision);
-	}
-	else if (number >= 1e6) {
-		return formatValue(number / 1e6, "M", precision);
-	}
-	else if (number >= 1e3) {
-		return formatValue(number / 1e3, "k", precision);
-	}
-	else {
-		if (precision == 0) {
-			return std::to_string(static_cast<int>(std::round(number)));
-		}
-		else {
-			std::ostringstream oss;
-			oss << std::fixed << std::setprecision(precision) << number;
-			return cleanDecimal(oss.str());
-		}
-	}
+	GW2_SCT::NumberBuffer buffer;
+	return std::string(GW2_SCT::FormatNumber(buffer, number, precision));
 }
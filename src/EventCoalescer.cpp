@@ -0,0 +1,68 @@
+#include "EventCoalescer.h"
+#include <algorithm>
+
+GW2_SCT::EventCoalescer::EventCoalescer(size_t maxPending) : maxPending(maxPending) {
+	size_t tableSize = 16;
+	while (tableSize < maxPending * 2) tableSize *= 2;
+	table.resize(tableSize);
+	pending.reserve(maxPending);
+}
+
+GW2_SCT::EventCoalescer::Key GW2_SCT::EventCoalescer::keyOf(const EventRecord& record) {
+	static_assert(EventRecord::maxTypes + EventRecord::maxCategories <= 4, "record shape has to fit in 32 bits");
+	uint32_t shape = 0;
+	for (size_t i = 0; i < record.typeCount; i++) shape = (shape << 8) | (static_cast<uint32_t>(record.types[i]) + 1);
+	for (size_t i = 0; i < record.categoryCount; i++) shape = (shape << 8) | (static_cast<uint32_t>(record.categories[i]) + 1);
+	return { record.src.id, record.dst.id, record.skillId, shape };
+}
+
+size_t GW2_SCT::EventCoalescer::hashOf(const Key& key) {
+	uint64_t h = key.src * 0x9E3779B97F4A7C15ull;
+	h ^= key.dst + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+	h ^= (uint64_t(key.skillId) << 32 | key.shape) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+	return static_cast<size_t>(h);
+}
+
+void GW2_SCT::EventCoalescer::index(const Key& key, uint32_t index) {
+	size_t mask = table.size() - 1;
+	for (size_t i = hashOf(key) & mask;; i = (i + 1) & mask) {
+		if (table[i].generation != generation) {
+			table[i] = { key, generation, index };
+			return;
+		}
+	}
+}
+
+void GW2_SCT::EventCoalescer::add(const EventRecord& record) {
+	Key key = keyOf(record);
+	size_t mask = table.size() - 1;
+	size_t i = hashOf(key) & mask;
+	for (; table[i].generation == generation; i = (i + 1) & mask) {
+		if (table[i].key == key) {
+			EventRecord& aggregate = pending[table[i].index];
+			aggregate.value += record.value;
+			aggregate.buffValue += record.buffValue;
+			aggregate.overstack_value += record.overstack_value;
+			aggregate.hitCount += record.hitCount;
+			stats.added++;
+			stats.folded++;
+			return;
+		}
+	}
+	table[i] = { key, generation, static_cast<uint32_t>(pending.size()) };
+	pending.push_back(record);
+	stats.added++;
+}
+
+void GW2_SCT::EventCoalescer::consume(size_t count) {
+	if (count == 0) return;
+	pending.erase(pending.begin(), pending.begin() + std::min(count, pending.size()));
+	if (++generation == 0) {
+		for (Slot& slot : table) slot.generation = 0;
+		generation = 1;
+	}
+	// Only after a frame ran over its budget, then the remaining records are indexed again
+	for (size_t i = 0; i < pending.size(); i++) {
+		index(keyOf(pending[i]), static_cast<uint32_t>(i));
+	}
+}
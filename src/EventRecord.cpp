@@ -0,0 +1,67 @@
+#include "EventRecord.h"
+#include "EventClassifier.h"
+
+bool GW2_SCT::buildEventRecord(EventIngestState& state, CombatHotOptions options, const cbtevent1& ev, const ag& src, const ag& dst, const char* skillname, UnknownNameFunction unknownName, EventRecord& record) {
+	if (src.self) {
+		state.selfInstId = ev.src_instid;
+	}
+	if (dst.self) {
+		state.selfInstId = ev.dst_instid;
+	}
+
+	if (ev.is_statechange || ev.is_activation || ev.is_buffremove) {
+		return false;
+	}
+
+	const ClassifiedEvent classified = classifyCombatEvent(ev);
+	if (classified.typeCount == 0) {
+		return false;
+	}
+
+	static_assert(ClassifiedEvent::maxTypes <= EventRecord::maxTypes, "EventRecord can not hold all classified types");
+	record = EventRecord();
+	record.timepoint = std::chrono::system_clock::now();
+	for (size_t i = 0; i < classified.typeCount; i++) {
+		record.types[i] = classified.types[i];
+	}
+	record.typeCount = classified.typeCount;
+
+	// Player outgoing damage/effects
+	if (src.self == 1 && (!options.outgoingOnlyToTarget || dst.id == state.targetAgentId)) {
+		if (!options.selfMessageOnlyIncoming || dst.self != 1) {
+			record.categories[record.categoryCount++] = MessageCategory::PLAYER_OUT;
+		}
+	}
+	// Pet outgoing damage/effects
+	else if (ev.src_master_instid == state.selfInstId && (!options.outgoingOnlyToTarget || dst.id == state.targetAgentId)) {
+		record.categories[record.categoryCount++] = MessageCategory::PET_OUT;
+	}
+
+	// Player incoming damage/effects
+	if (dst.self == 1) {
+		record.categories[record.categoryCount++] = MessageCategory::PLAYER_IN;
+	}
+	// Pet incoming damage/effects
+	else if (ev.dst_master_instid == state.selfInstId) {
+		record.categories[record.categoryCount++] = MessageCategory::PET_IN;
+	}
+
+	if (record.categoryCount == 0) {
+		return false;
+	}
+
+	/* default names, interned under their id like real names so that they also resolve without locking */
+	const char* skillNameText = skillname != nullptr && *skillname != '\0' ? skillname : unknownName(UnknownName::SKILL);
+	const char* srcNameText = src.name != nullptr && *src.name != '\0' ? src.name : unknownName(UnknownName::SOURCE);
+	const char* dstNameText = dst.name != nullptr && *dst.name != '\0' ? dst.name : unknownName(UnknownName::TARGET);
+	EventNames names = StringInterner::internEventNames(ev.skillid, skillNameText, src.id, srcNameText, dst.id, dstNameText);
+
+	record.value = classified.value;
+	record.overstack_value = ev.overstack_value;
+	record.buffValue = classified.buffValue;
+	record.skillId = ev.skillid;
+	record.skillName = names.skillName;
+	record.src = { src.id, src.prof, names.srcName };
+	record.dst = { dst.id, dst.prof, names.dstName };
+	return true;
+}
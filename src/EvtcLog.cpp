@@ -0,0 +1,97 @@
+#include "EvtcLog.h"
+#include <cstring>
+
+namespace {
+	constexpr size_t evtcHeaderSize = 16;
+	constexpr size_t evtcAgentSize = 96;
+	constexpr size_t evtcSkillSize = 68;
+	constexpr size_t evtcNameSize = 64;
+	constexpr uint8_t evtcStateChangePointOfView = 13;
+	static_assert(sizeof(cbtevent1) == 64, "cbtevent1 has to match the evtc revision 1 event layout");
+
+	class EvtcReader {
+	public:
+		EvtcReader(const std::vector<char>& data) : data(data) {}
+		bool has(size_t size) const { return pos + size <= data.size(); }
+		template <class T>
+		T read() {
+			T value;
+			memcpy(&value, data.data() + pos, sizeof(T));
+			pos += sizeof(T);
+			return value;
+		}
+		std::string readName(size_t size) {
+			const char* begin = data.data() + pos;
+			pos += size;
+			return std::string(begin, strnlen(begin, size));
+		}
+		void skip(size_t size) { pos += size; }
+		size_t remaining() const { return data.size() - pos; }
+	private:
+		const std::vector<char>& data;
+		size_t pos = 0;
+	};
+}
+
+std::shared_ptr<GW2_SCT::EvtcLog> GW2_SCT::EvtcLog::parse(const std::vector<char>& data, std::string& error) {
+	EvtcReader reader(data);
+	if (!reader.has(evtcHeaderSize) || memcmp(data.data(), "EVTC", 4) != 0) {
+		error = data.size() >= 2 && data[0] == 'P' && data[1] == 'K' ? "Compressed logs are not supported, extract the .zevtc first." : "Not an evtc log.";
+		return nullptr;
+	}
+	reader.skip(12);
+	uint8_t revision = reader.read<uint8_t>();
+	reader.skip(3);
+	if (revision != 1) {
+		error = "Unsupported evtc revision " + std::to_string(revision) + ".";
+		return nullptr;
+	}
+
+	auto evtc = std::make_shared<GW2_SCT::EvtcLog>();
+	if (!reader.has(sizeof(uint32_t))) {
+		error = "Truncated agent table.";
+		return nullptr;
+	}
+	uint32_t agentCount = reader.read<uint32_t>();
+	if (!reader.has(size_t(agentCount) * evtcAgentSize)) {
+		error = "Truncated agent table.";
+		return nullptr;
+	}
+	evtc->agents.reserve(agentCount);
+	for (uint32_t i = 0; i < agentCount; i++) {
+		GW2_SCT::EvtcLog::Agent agent;
+		agent.addr = reader.read<uint64_t>();
+		agent.prof = reader.read<uint32_t>();
+		agent.elite = reader.read<uint32_t>();
+		reader.skip(6 * sizeof(int16_t)); // toughness, concentration, healing, hitbox width, condition, hitbox height
+		agent.name = reader.readName(evtcNameSize); // players: character name, account and subgroup, the first is what arcdps reports
+		reader.skip(evtcAgentSize - 8 - 4 - 4 - 6 * sizeof(int16_t) - evtcNameSize);
+		evtc->agentIndex[agent.addr] = evtc->agents.size();
+		evtc->agents.push_back(std::move(agent));
+	}
+
+	if (!reader.has(sizeof(uint32_t))) {
+		error = "Truncated skill table.";
+		return nullptr;
+	}
+	uint32_t skillCount = reader.read<uint32_t>();
+	if (!reader.has(size_t(skillCount) * evtcSkillSize)) {
+		error = "Truncated skill table.";
+		return nullptr;
+	}
+	for (uint32_t i = 0; i < skillCount; i++) {
+		int32_t id = reader.read<int32_t>();
+		evtc->skillNames[static_cast<uint32_t>(id)] = reader.readName(evtcNameSize);
+	}
+
+	size_t eventCount = reader.remaining() / sizeof(cbtevent1);
+	evtc->events.reserve(eventCount);
+	for (size_t i = 0; i < eventCount; i++) {
+		cbtevent1 ev = reader.read<cbtevent1>();
+		if (ev.is_statechange == evtcStateChangePointOfView) {
+			evtc->povAddr = ev.src_agent;
+		}
+		evtc->events.push_back(ev);
+	}
+	return evtc;
+}
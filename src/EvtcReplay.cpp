@@ -0,0 +1,152 @@
+#include "EvtcReplay.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "EvtcLog.h"
+#if _DEBUG
+#include <crtdbg.h>
+#endif
+
+namespace {
+	int64_t nowNanos() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+#if _DEBUG
+	// The debug heap reports every allocation of the process to the hook, only those of the replay thread
+	// inside CombatEventLocal are counted. Any hook installed before is still called.
+	thread_local bool countAllocations = false;
+	thread_local uint64_t countedAllocations = 0;
+	_CRT_ALLOC_HOOK previousAllocHook = nullptr;
+
+	int countingAllocHook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber) {
+		if (countAllocations && allocType != _HOOK_FREE) {
+			countedAllocations++;
+		}
+		return previousAllocHook != nullptr ? previousAllocHook(allocType, userData, size, blockType, requestNumber, fileName, lineNumber) : TRUE;
+	}
+#endif
+}
+
+GW2_SCT::SCTMain* GW2_SCT::EvtcReplay::main = nullptr;
+std::thread* GW2_SCT::EvtcReplay::replayThread = nullptr;
+std::atomic<bool> GW2_SCT::EvtcReplay::running = false;
+std::atomic<bool> GW2_SCT::EvtcReplay::stopRequested = false;
+std::atomic<uint64_t> GW2_SCT::EvtcReplay::eventsTotal = 0;
+std::atomic<uint64_t> GW2_SCT::EvtcReplay::eventsReplayed = 0;
+std::atomic<uint64_t> GW2_SCT::EvtcReplay::ingestNanos = 0;
+std::atomic<uint64_t> GW2_SCT::EvtcReplay::ingestAllocations = 0;
+std::atomic<int64_t> GW2_SCT::EvtcReplay::startNanos = 0;
+std::atomic<int64_t> GW2_SCT::EvtcReplay::endNanos = 0;
+std::string GW2_SCT::EvtcReplay::lastError = "";
+
+bool GW2_SCT::EvtcReplay::start(const std::string& path, bool recordedPacing) {
+	stop();
+	lastError.clear();
+
+	std::ifstream file(getSCTPath() + path, std::ios::binary);
+	if (!file.good()) file = std::ifstream(path, std::ios::binary);
+	if (!file.good()) {
+		lastError = "Could not open " + path + ".";
+		LOG("EVTC replay: ", lastError);
+		return false;
+	}
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::shared_ptr<const EvtcLog> evtc = EvtcLog::parse(data, lastError);
+	if (evtc == nullptr) {
+		LOG("EVTC replay: ", lastError);
+		return false;
+	}
+	LOG("EVTC replay: loaded ", evtc->events.size(), " events, ", evtc->agents.size(), " agents and ", evtc->skillNames.size(), " skills from ", path);
+
+	eventsTotal = evtc->events.size();
+	eventsReplayed = 0;
+	ingestNanos = 0;
+	ingestAllocations = 0;
+	startNanos = nowNanos();
+	endNanos = 0;
+	stopRequested = false;
+	running = true;
+	replayThread = new std::thread(EvtcReplay::replay, evtc, recordedPacing);
+	return true;
+}
+
+void GW2_SCT::EvtcReplay::stop() {
+	if (replayThread == nullptr) return;
+	stopRequested = true;
+	replayThread->join();
+	delete replayThread;
+	replayThread = nullptr;
+}
+
+GW2_SCT::EvtcReplayStats GW2_SCT::EvtcReplay::getStats() {
+	EvtcReplayStats stats;
+	stats.running = running;
+	stats.eventsTotal = eventsTotal;
+	stats.eventsReplayed = eventsReplayed;
+	stats.ingestNanos = ingestNanos;
+	stats.ingestAllocations = ingestAllocations;
+	int64_t end = running ? nowNanos() : endNanos.load();
+	stats.elapsedSeconds = startNanos != 0 ? (end - startNanos) / 1e9 : 0;
+	return stats;
+}
+
+void GW2_SCT::EvtcReplay::replay(std::shared_ptr<const EvtcLog> evtc, bool recordedPacing) {
+	std::vector<ag> agents(evtc->agents.size());
+	for (size_t i = 0; i < agents.size(); i++) {
+		const EvtcLog::Agent& agent = evtc->agents[i];
+		agents[i] = { agent.name.c_str(), static_cast<uintptr_t>(agent.addr), agent.prof, agent.elite, agent.addr == evtc->povAddr ? 1u : 0u, 0 };
+	}
+	ag unknownAgent = { nullptr, 0, 0, 0, 0, 0 };
+	auto findAgent = [&](uint64_t addr) -> ag* {
+		auto found = evtc->agentIndex.find(addr);
+		return found != evtc->agentIndex.end() ? &agents[found->second] : &unknownAgent;
+	};
+
+#if _DEBUG
+	previousAllocHook = _CrtSetAllocHook(countingAllocHook);
+#endif
+	auto replayStart = std::chrono::steady_clock::now();
+	uint64_t firstEventTime = evtc->events.empty() ? 0 : evtc->events.front().time;
+	uint64_t eventId = 0;
+	for (const cbtevent1& recorded : evtc->events) {
+		if (stopRequested) break;
+		if (recordedPacing && recorded.time > firstEventTime) {
+			auto due = replayStart + std::chrono::milliseconds(recorded.time - firstEventTime);
+			while (!stopRequested && std::chrono::steady_clock::now() < due) {
+				std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(due - std::chrono::steady_clock::now(), std::chrono::milliseconds(50)));
+			}
+		}
+
+		cbtevent1 ev = recorded;
+		ag* src = findAgent(ev.src_agent);
+		ag* dst = findAgent(ev.dst_agent);
+		auto skillName = evtc->skillNames.find(ev.skillid);
+		char* skillname = skillName != evtc->skillNames.end() ? const_cast<char*>(skillName->second.c_str()) : nullptr;
+
+		int64_t ingestStart = nowNanos();
+#if _DEBUG
+		uint64_t allocationsBefore = countedAllocations;
+		countAllocations = true;
+#endif
+		if (main != nullptr) {
+			main->CombatEventLocal(reinterpret_cast<cbtevent*>(&ev), src, dst, skillname, ++eventId, 1);
+		}
+#if _DEBUG
+		countAllocations = false;
+		ingestAllocations += countedAllocations - allocationsBefore;
+#endif
+		ingestNanos += nowNanos() - ingestStart;
+		eventsReplayed++;
+	}
+
+#if _DEBUG
+	_CrtSetAllocHook(previousAllocHook);
+#endif
+	endNanos = nowNanos();
+	running = false;
+	EvtcReplayStats stats = getStats();
+	LOG("EVTC replay: ", stats.eventsReplayed, "/", stats.eventsTotal, " events in ", stats.elapsedSeconds, "s (", stats.eventsPerSecond(), " events/s, ", stats.ingestNanosPerEvent(), "ns and ", stats.ingestAllocationsPerEvent(), " allocations ingest per event)");
+}
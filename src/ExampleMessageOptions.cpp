@@ -5,6 +5,7 @@
 #include "imgui_sct_widgets.h"
 #include "Options.h"
 #include "Language.h"
+#include "EvtcReplay.h"
 
 bool GW2_SCT::ExampleMessageOptions::windowIsOpen = false;
 GW2_SCT::ExampleMessageOptions::State GW2_SCT::ExampleMessageOptions::state = GW2_SCT::ExampleMessageOptions::State::READY_TO_RECORD;
@@ -14,30 +15,38 @@ std::thread* GW2_SCT::ExampleMessageOptions::emitterThread = nullptr;
 
 #ifdef _DEBUG
 using namespace std::chrono_literals;
-cbtevent1 minimalEvent(int32_t value, int32_t buff_dmg, uint32_t overstack_value, uint32_t skillid) {
-	cbtevent1 ret;
-	ret.value = value;
-	ret.overstack_value = buff_dmg;
-	ret.buff_dmg = overstack_value;
-	ret.skillid = skillid;
-	return ret;
-}
 ag agMe { "Me", 1, profession::PROFESSION_ELEMENTALIST, 0, 1 };
 ag agFoe { "Foe", 2, profession::PROFESSION_ENGINEER, 0, 0 };
 ag agFriend { "Friend", 3, profession::PROFESSION_GUARDIAN, 0, 0 };
 ag agPet { "Pet", 4, profession::PROFESSION_UNDEFINED, 0, 0 };
+
+GW2_SCT::EventRecord exampleRecord(GW2_SCT::MessageCategory category, GW2_SCT::MessageType type, int32_t value, int32_t buffValue, uint32_t overstack_value, uint32_t skillId, ag* entity, ag* otherEntity, const char* skillname) {
+	GW2_SCT::EventRecord ret;
+	ret.categories[ret.categoryCount++] = category;
+	ret.types[ret.typeCount++] = type;
+	ret.value = value;
+	ret.buffValue = buffValue;
+	ret.overstack_value = overstack_value;
+	ret.skillId = skillId;
+	ret.skillName = GW2_SCT::StringInterner::intern(skillname);
+	GW2_SCT::EventAgent entityAgent = { entity->id, entity->prof, GW2_SCT::StringInterner::intern(entity->name) };
+	GW2_SCT::EventAgent otherEntityAgent = { otherEntity->id, otherEntity->prof, GW2_SCT::StringInterner::intern(otherEntity->name) };
+	ret.src = GW2_SCT::isIncomingCategory(category) ? entityAgent : otherEntityAgent;
+	ret.dst = GW2_SCT::isIncomingCategory(category) ? otherEntityAgent : entityAgent;
+	return ret;
+}
 #endif // _DEBUG
 
 
-std::multimap<std::chrono::system_clock::duration, GW2_SCT::ExampleMessageOptions::MessageInformation> GW2_SCT::ExampleMessageOptions::messagesToEmmit = {
+std::multimap<std::chrono::system_clock::duration, GW2_SCT::EventRecord> GW2_SCT::ExampleMessageOptions::messagesToEmmit = {
 #ifdef _DEBUG
-	{ std::chrono::system_clock::duration(0ms), { GW2_SCT::MessageCategory::PLAYER_OUT, GW2_SCT::MessageType::PHYSICAL, std::make_shared<GW2_SCT::MessageData>(-1234, 0, 0, 5489, &agMe, &agFoe, "Lightning Whip")}},
-	{ std::chrono::system_clock::duration(100ms), { GW2_SCT::MessageCategory::PLAYER_OUT, GW2_SCT::MessageType::CRIT, std::make_shared<GW2_SCT::MessageData>(-1855, 0, 0, 5489, &agMe, &agFoe, "Lightning Whip")}},
-	{ std::chrono::system_clock::duration(0ms), { GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::PHYSICAL, std::make_shared<GW2_SCT::MessageData>(-123, 0, 0, 5827, &agFoe, &agMe, "Fragmentation Shot")}},
-	{ std::chrono::system_clock::duration(250ms), { GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, std::make_shared<GW2_SCT::MessageData>(0, -789, 0, 736, &agFoe, &agMe, "Fragmentation Shot")}},
-	{ std::chrono::system_clock::duration(500ms), { GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, std::make_shared<GW2_SCT::MessageData>(0, -789, 0, 736, &agFoe, &agMe, "Fragmentation Shot")}},
-	{ std::chrono::system_clock::duration(750ms), { GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, std::make_shared<GW2_SCT::MessageData>(0, -456, 0, 736, &agFoe, &agMe, "Fragmentation Shot")}},
-	{ std::chrono::system_clock::duration(1000ms), { GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, std::make_shared<GW2_SCT::MessageData>(0, -34, 0, 736, &agFoe, &agMe, "Fragmentation Shot")}}
+	{ std::chrono::system_clock::duration(0ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_OUT, GW2_SCT::MessageType::PHYSICAL, -1234, 0, 0, 5489, &agMe, &agFoe, "Lightning Whip")},
+	{ std::chrono::system_clock::duration(100ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_OUT, GW2_SCT::MessageType::CRIT, -1855, 0, 0, 5489, &agMe, &agFoe, "Lightning Whip")},
+	{ std::chrono::system_clock::duration(0ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::PHYSICAL, -123, 0, 0, 5827, &agFoe, &agMe, "Fragmentation Shot")},
+	{ std::chrono::system_clock::duration(250ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, 0, -789, 0, 736, &agFoe, &agMe, "Fragmentation Shot")},
+	{ std::chrono::system_clock::duration(500ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, 0, -789, 0, 736, &agFoe, &agMe, "Fragmentation Shot")},
+	{ std::chrono::system_clock::duration(750ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, 0, -456, 0, 736, &agFoe, &agMe, "Fragmentation Shot")},
+	{ std::chrono::system_clock::duration(1000ms), exampleRecord(GW2_SCT::MessageCategory::PLAYER_IN, GW2_SCT::MessageType::BLEEDING, 0, -34, 0, 736, &agFoe, &agMe, "Fragmentation Shot")}
 #endif // _DEBUG
 };
 
@@ -73,19 +82,25 @@ void GW2_SCT::ExampleMessageOptions::paint() {
 
 		ImGui::BeginChild("messagesToEmitPane", ImVec2(ImGui::GetWindowWidth(), -ImGui::GetFrameHeightWithSpacing()), true);
 		int i = 0;
-		static MessageInformation* currentlyEditing = nullptr;
+		static EventRecord* currentlyEditing = nullptr;
 		for (auto messageToEmmit = messagesToEmmit.begin(); messageToEmmit != messagesToEmmit.end(); messageToEmmit++) {
 			std::string s = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(messageToEmmit->first).count()) + "." + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(messageToEmmit->first).count() % 1000 / 10) + "s";
-			s += " - " + categoryNames.at(messageToEmmit->second.category);
-			s += " | " + typeNames.at(messageToEmmit->second.type) + " - ";
-			if (messageToEmmit->second.data->entityName != nullptr) {
-				s += " " + std::string(messageToEmmit->second.data->entityName);
+			const EventRecord& record = messageToEmmit->second;
+			for (size_t c = 0; c < record.categoryCount; c++) {
+				s += (c == 0 ? " - " : ", ") + categoryNames.at(record.categories[c]);
+			}
+			for (size_t t = 0; t < record.typeCount; t++) {
+				s += (t == 0 ? " | " : ", ") + typeNames.at(record.types[t]);
+			}
+			s += " - ";
+			if (record.src.name != 0) {
+				s += " " + std::string(StringInterner::view(record.src.name));
 			}
-			if (messageToEmmit->second.data->otherEntityName != nullptr) {
-				s += " -> " + std::string(messageToEmmit->second.data->otherEntityName);
+			if (record.dst.name != 0) {
+				s += " -> " + std::string(StringInterner::view(record.dst.name));
 			}
-			if (messageToEmmit->second.data->skillName != nullptr) {
-				s += " (" + std::string(messageToEmmit->second.data->skillName) + ")";
+			if (record.skillName != 0) {
+				s += " (" + std::string(StringInterner::view(record.skillName)) + ")";
 			}
 			ImGui::SetCursorPosY(ImGui::GetCursorPosY() + style.FramePadding.y);
 			ImGui::Text(s.c_str());
@@ -128,6 +143,32 @@ void GW2_SCT::ExampleMessageOptions::paint() {
 		}
 		if (messagesEmpty) ImGui::EndDisabled();
 
+#ifdef _DEBUG
+		ImGui::Separator();
+		static std::string replayPath = "replay.evtc";
+		static bool replayRecordedPacing = false;
+		bool replayRunning = EvtcReplay::isRunning();
+		if (replayRunning) ImGui::BeginDisabled();
+		ImGui::InputText("EVTC log", &replayPath);
+		ImGui::Checkbox("Recorded pacing", &replayRecordedPacing);
+		if (replayRunning) ImGui::EndDisabled();
+		if (!replayRunning) {
+			if (ImGui::Button("Replay log")) {
+				EvtcReplay::start(replayPath, replayRecordedPacing);
+			}
+		}
+		else if (ImGui::Button("Stop replay")) {
+			EvtcReplay::stop();
+		}
+		if (!EvtcReplay::getLastError().empty()) {
+			ImGui::TextUnformatted(EvtcReplay::getLastError().c_str());
+		}
+		EvtcReplayStats replayStats = EvtcReplay::getStats();
+		if (replayStats.eventsTotal > 0) {
+			ImGui::Text("%llu/%llu events, %.0f events/s, %.0fns and %.3f allocations ingest per event", replayStats.eventsReplayed, replayStats.eventsTotal, replayStats.eventsPerSecond(), replayStats.ingestNanosPerEvent(), replayStats.ingestAllocationsPerEvent());
+		}
+#endif // _DEBUG
+
 		ImGui::End();
 		ImGui::PopStyleVar();
 		ImGui::PopStyleColor();
@@ -136,12 +177,9 @@ void GW2_SCT::ExampleMessageOptions::paint() {
 	}
 }
 
-void GW2_SCT::ExampleMessageOptions::receiveMessage(std::shared_ptr<EventMessage> m) {
+void GW2_SCT::ExampleMessageOptions::receiveMessage(const EventRecord& record) {
 	if (state == State::RECORDING) {
-		auto messageDataCopy = m->getCopyOfFirstData();
-		if (!messageDataCopy->hasToBeFiltered) {
-			messagesToEmmit.insert(std::pair<std::chrono::system_clock::duration, MessageInformation>(m->getTimepoint() - recordingStart, { m->getCategory(), m->getType(), messageDataCopy }));
-		}
+		messagesToEmmit.insert(std::pair<std::chrono::system_clock::duration, EventRecord>(record.timepoint - recordingStart, record));
 	}
 }
 
@@ -153,7 +191,9 @@ void GW2_SCT::ExampleMessageOptions::emitMessages() {
 			if (state != State::EMITTING) return;
 		}
 		if (main != nullptr) {
-			main->sendMessageToEmission(std::make_shared<EventMessage>(it->second.category, it->second.type, it->second.data));
+			EventRecord record = it->second;
+			record.timepoint = std::chrono::system_clock::now();
+			main->sendMessageToEmission(record);
 		}
 	}
 	state = State::READY_TO_RECORD;
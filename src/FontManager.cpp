@@ -396,56 +396,59 @@ void GW2_SCT::FontType::bakeGlyphsAtSize(std::string text, float fontSize) {
 void GW2_SCT::FontType::drawAtSize(std::string text, float fontSize, ImVec2 pos, ImU32 color) {
     if (text.size() == 0) return;
 
+    thread_local std::vector<GlyphQuad> quads;
+    quads.clear();
+    layoutAtSize(text, fontSize, quads);
+    drawLayout(quads, pos, color);
+}
+
+void GW2_SCT::FontType::layoutAtSize(const std::string& text, float fontSize, std::vector<GlyphQuad>& out) {
+    if (text.size() == 0) return;
+
     float scale = getCachedScale(fontSize);
 
-    std::vector<GlyphPositionDefinition> definitions;
+    thread_local std::vector<GlyphPositionDefinition> definitions;
+    definitions.clear();
     {
         std::lock_guard<std::mutex> gpLock(_glyphPositionsMutex);
+        auto scaleIt = _glyphPositionsAtSizes.find(scale);
+        if (scaleIt == _glyphPositionsAtSizes.end()) return;
         for (size_t i = 0; i < text.size();) {
             int codePointLength = getCodepointLength(text, i);
             int codePoint = getCodepointOfLength(text, i, codePointLength);
             i += codePointLength;
 
-            auto scaleIt = _glyphPositionsAtSizes.find(scale);
-            if (scaleIt != _glyphPositionsAtSizes.end()) {
-                auto it = scaleIt->second.find(codePoint);
-                if (it != scaleIt->second.end()) {
-                    definitions.push_back(it->second);
-                }
+            auto it = scaleIt->second.find(codePoint);
+            if (it != scaleIt->second.end()) {
+                definitions.push_back(it->second);
             }
         }
     }
     if (definitions.empty()) return;
 
-    ImVec2 currentPos(pos.x - definitions.front().glyph->getLeftSideBearing(), pos.y);
+    float realScaleFraction = isCachedScaleExactForSize(fontSize) ? 1.f : getRealScale(fontSize) / scale;
+    float x = -definitions.front().glyph->getLeftSideBearing();
 
     std::lock_guard lock(_allocatedAtlassesMutex);
-
-    if (isCachedScaleExactForSize(fontSize)) {
-        for (size_t i = 0; i < definitions.size(); i++) {
-            auto& def = definitions[i];
-            if (_allocatedAtlases[def.atlasID]->texture != nullptr) {
-                ImVec2 thisCharPos(ceil(currentPos.x + def.glyph->getLeftSideBearing()),
-                    ceil(currentPos.y + def.glyph->getOffsetTop()));
-                _allocatedAtlases[def.atlasID]->texture->draw(thisCharPos, def.getSize(), def.uvStart, def.uvEnd, color);
-                currentPos.x += def.glyph->getAdvanceAndKerning(i + 1 >= definitions.size()
-                    ? 0 : definitions[i + 1].glyph->getCodepoint());
-            }
+    out.reserve(out.size() + definitions.size());
+    for (size_t i = 0; i < definitions.size(); i++) {
+        auto& def = definitions[i];
+        if (def.glyph->getWidth() > 0 && def.glyph->getHeight() > 0 && _allocatedAtlases[def.atlasID]->texture != nullptr) {
+            out.push_back({
+                _allocatedAtlases[def.atlasID]->texture,
+                ImVec2(x + realScaleFraction * def.glyph->getLeftSideBearing(), realScaleFraction * def.glyph->getOffsetTop()),
+                def.getSize(realScaleFraction),
+                def.uvStart, def.uvEnd
+            });
         }
+        x += realScaleFraction * def.glyph->getAdvanceAndKerning(i + 1 >= definitions.size()
+            ? 0 : definitions[i + 1].glyph->getCodepoint());
     }
-    else {
-        float realScaleFraction = getRealScale(fontSize) / scale;
-        for (size_t i = 0; i < definitions.size(); i++) {
-            auto& def = definitions[i];
-            if (_allocatedAtlases[def.atlasID]->texture != nullptr) {
-                ImVec2 thisCharPos(ceil(currentPos.x + realScaleFraction * def.glyph->getLeftSideBearing()),
-                    ceil(currentPos.y + realScaleFraction * def.glyph->getOffsetTop()));
-                _allocatedAtlases[def.atlasID]->texture->draw(thisCharPos, def.getSize(realScaleFraction),
-                    def.uvStart, def.uvEnd, color);
-                currentPos.x += realScaleFraction * def.glyph->getAdvanceAndKerning(i + 1 >= definitions.size()
-                    ? 0 : definitions[i + 1].glyph->getCodepoint());
-            }
-        }
+}
+
+void GW2_SCT::FontType::drawLayout(const std::vector<GlyphQuad>& quads, ImVec2 pos, ImU32 color) {
+    for (const GlyphQuad& quad : quads) {
+        quad.texture->draw(ImVec2(ceil(pos.x + quad.offset.x), ceil(pos.y + quad.offset.y)), quad.size, quad.uvStart, quad.uvEnd, color);
     }
 }
 
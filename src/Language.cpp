@@ -89,6 +89,22 @@ std::map<GW2_SCT::LanguageCategory, std::map<GW2_SCT::LanguageKey, GW2_SCT::Lang
         { GW2_SCT::LanguageKey::General_Self_Only_As_Incoming_Toolip, {} },
         { GW2_SCT::LanguageKey::General_Out_Only_For_Target, {} },
         { GW2_SCT::LanguageKey::General_Out_Only_For_Target_Toolip, {} },
+        { GW2_SCT::LanguageKey::General_Coalesce_Events, {} },
+        { GW2_SCT::LanguageKey::General_Coalesce_Events_Toolip, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Mode, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Toolip, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Off, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Drop_Lowest, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Drop_Oldest, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Collapse, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Queue_Depth, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Frame_Budget, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Frame_Budget_Toolip, {} },
+        { GW2_SCT::LanguageKey::General_Overload_Counters, {} },
+        { GW2_SCT::LanguageKey::General_Number_Format, {} },
+        { GW2_SCT::LanguageKey::General_Number_Format_Toolip, {} },
+        { GW2_SCT::LanguageKey::General_Draw_Counters, {} },
+        { GW2_SCT::LanguageKey::General_Overload_More, {} },
         { GW2_SCT::LanguageKey::Scroll_Areas_Name, {} },
         { GW2_SCT::LanguageKey::Receiver_Name, {} },
         { GW2_SCT::LanguageKey::Messages_Category, {} },
@@ -192,6 +208,8 @@ std::map<GW2_SCT::LanguageCategory, std::map<GW2_SCT::LanguageKey, GW2_SCT::Lang
         { GW2_SCT::LanguageKey::Delete_Confirmation_Cancel, {} },
         { GW2_SCT::LanguageKey::Merge_Crit_With_Hit, {} },
         { GW2_SCT::LanguageKey::Merge_Crit_With_Hit_Tooltip, {} },
+        { GW2_SCT::LanguageKey::Combine_Window, {} },
+        { GW2_SCT::LanguageKey::Combine_Window_Tooltip, {} },
         { GW2_SCT::LanguageKey::Horizontal_Offset, {} },
         { GW2_SCT::LanguageKey::Vertical_Offset, {} },
         { GW2_SCT::LanguageKey::Width, {} },
@@ -224,6 +242,16 @@ std::map<GW2_SCT::LanguageCategory, std::map<GW2_SCT::LanguageKey, GW2_SCT::Lang
         { GW2_SCT::LanguageKey::Delete_Confirmation_Cancel, {} },
         { GW2_SCT::LanguageKey::Template, {} },
         { GW2_SCT::LanguageKey::Available_Parameters, {} },
+        { GW2_SCT::LanguageKey::Template_Error_At, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Lone_Closing_Bracket, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Unterminated_Tag, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Unknown_Tag, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Missing_Tag_Value, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Invalid_Color, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Invalid_Icon, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Unexpected_Closing_Tag, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Unclosed_Tag, {} },
+        { GW2_SCT::LanguageKey::Template_Error_Unknown_Parameter, {} },
     } },
     { GW2_SCT::LanguageCategory::Skill_Filter_Option_UI, {
         { GW2_SCT::LanguageKey::Filter_By, {} },
@@ -251,6 +279,7 @@ std::map<GW2_SCT::LanguageCategory, std::map<GW2_SCT::LanguageKey, GW2_SCT::Lang
         { GW2_SCT::LanguageKey::Add_Filter_Button_Text, {} },
         { GW2_SCT::LanguageKey::Used_By_Label, {} },
         { GW2_SCT::LanguageKey::Not_Assigned_Info, {} },
+        { GW2_SCT::LanguageKey::Filter_Cache_Hit_Rate, {} },
         { GW2_SCT::LanguageKey::Select_Filter_Set_Hint_Line1, {} },
         { GW2_SCT::LanguageKey::Select_Filter_Set_Hint_Line2, {} },
     } },
@@ -1096,6 +1125,22 @@ const nlohmann::ordered_json GW2_SCT::Language::defaultLanguage = convertLanguag
         { GW2_SCT::LanguageKey::General_Self_Only_As_Incoming_Toolip, "This option effects only messages with both the source and destination\nbeing yourself.\nIf enabled these messages will only be triggered as 'Player Incoming'\nmessages.\nIf disabled these messages will be triggered as both 'Player Incoming'\nand 'Player outgoing' messages." },
         { GW2_SCT::LanguageKey::General_Out_Only_For_Target, "Show outgoing messages only for target" },
         { GW2_SCT::LanguageKey::General_Out_Only_For_Target_Toolip, "If enabled only messages that have your current target as destination will\nbe triggered in both categories 'Player Outgoing' and 'Pet Outgoing'." },
+        { GW2_SCT::LanguageKey::General_Coalesce_Events, "Combine same-skill hits before display" },
+        { GW2_SCT::LanguageKey::General_Coalesce_Events_Toolip, "If enabled hits of the same skill between the same source and target that\narrive within one frame are added up into a single message before they\nreach the scroll areas. This lowers the load in large fights, but such hits\nare combined even for message types that are not combined otherwise." },
+        { GW2_SCT::LanguageKey::General_Overload_Mode, "Overload handling" },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Toolip, "What happens when more messages arrive than a scroll area can show.\nDrop lowest value: discard the pending message with the smallest value.\nDrop oldest: discard the message that has been waiting the longest.\nCollapse: replace the overflow with a single \"+N more\" line.\nIn every mode except Off, events beyond the frame budget are kept for the\nnext frame." },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Off, "Off" },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Drop_Lowest, "Drop lowest value" },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Drop_Oldest, "Drop oldest" },
+        { GW2_SCT::LanguageKey::General_Overload_Mode_Collapse, "Collapse into \"+N more\"" },
+        { GW2_SCT::LanguageKey::General_Overload_Queue_Depth, "Max. pending messages per scroll area" },
+        { GW2_SCT::LanguageKey::General_Overload_Frame_Budget, "Event processing budget per frame (ms)" },
+        { GW2_SCT::LanguageKey::General_Overload_Frame_Budget_Toolip, "Time each frame may spend distributing new events to the scroll areas.\n0 means unlimited." },
+        { GW2_SCT::LanguageKey::General_Overload_Counters, "Dropped: %llu, collapsed: %llu, deferred frames: %llu, queue overflow: %llu" },
+        { GW2_SCT::LanguageKey::General_Number_Format, "Number format" },
+        { GW2_SCT::LanguageKey::General_Number_Format_Toolip, "How numbers in messages are written: the decimal separator and whether\nthousands are grouped." },
+        { GW2_SCT::LanguageKey::General_Draw_Counters, "Last frame: %u text and icon quads, %u texture switches in paint order, %u draw commands after grouping" },
+        { GW2_SCT::LanguageKey::General_Overload_More, "+%llu more" },
         { GW2_SCT::LanguageKey::Scroll_Areas_Name, "Scroll Area Name" },
         { GW2_SCT::LanguageKey::Receiver_Name, "Receiver Name" },
         { GW2_SCT::LanguageKey::Messages_Category, "Message Category" },
@@ -1199,6 +1244,8 @@ const nlohmann::ordered_json GW2_SCT::Language::defaultLanguage = convertLanguag
         { GW2_SCT::LanguageKey::Delete_Confirmation_Cancel, "Cancel" },
         { GW2_SCT::LanguageKey::Merge_Crit_With_Hit, "Treat crits as hits" },
         { GW2_SCT::LanguageKey::Merge_Crit_With_Hit_Tooltip, "Route crit messages to hit receivers and combine them together for this scroll area. Hides crit receivers in the list." },
+        { GW2_SCT::LanguageKey::Combine_Window, "Combine window (ms)" },
+        { GW2_SCT::LanguageKey::Combine_Window_Tooltip, "Hits are also added to messages that are already shown if those appeared at\nmost this many milliseconds ago, updating their text in place. 0 only combines\nmessages that are still waiting to be shown." },
         { GW2_SCT::LanguageKey::Horizontal_Offset, "Horizontal Offset" },
         { GW2_SCT::LanguageKey::Vertical_Offset, "Vertical Offset" },
         { GW2_SCT::LanguageKey::Width, "Width" },
@@ -1231,6 +1278,16 @@ const nlohmann::ordered_json GW2_SCT::Language::defaultLanguage = convertLanguag
         { GW2_SCT::LanguageKey::Delete_Confirmation_Cancel, "Cancel" },
         { GW2_SCT::LanguageKey::Template, "Template" },
         { GW2_SCT::LanguageKey::Available_Parameters, "Available template parameters" },
+        { GW2_SCT::LanguageKey::Template_Error_At, "Column %i: %s" },
+        { GW2_SCT::LanguageKey::Template_Error_Lone_Closing_Bracket, "\"]\" has to be written as \"]]\"" },
+        { GW2_SCT::LanguageKey::Template_Error_Unterminated_Tag, "tag is missing its closing \"]\", write \"[[\" for a literal \"[\"" },
+        { GW2_SCT::LanguageKey::Template_Error_Unknown_Tag, "unknown tag, only col and icon are supported" },
+        { GW2_SCT::LanguageKey::Template_Error_Missing_Tag_Value, "tag needs a value, like [col=FFFFFF] or [icon=1234]" },
+        { GW2_SCT::LanguageKey::Template_Error_Invalid_Color, "color has to be six upper case hex digits or %c" },
+        { GW2_SCT::LanguageKey::Template_Error_Invalid_Icon, "icon has to be a skill id" },
+        { GW2_SCT::LanguageKey::Template_Error_Unexpected_Closing_Tag, "closing tag does not match the last opened tag" },
+        { GW2_SCT::LanguageKey::Template_Error_Unclosed_Tag, "tag is never closed" },
+        { GW2_SCT::LanguageKey::Template_Error_Unknown_Parameter, "unknown parameter, write \"%%\" for a literal \"%\"" },
     } },
     { GW2_SCT::LanguageCategory::Skill_Filter_Option_UI, {
         { GW2_SCT::LanguageKey::Filter_By, "Filter by" },
@@ -1258,6 +1315,7 @@ const nlohmann::ordered_json GW2_SCT::Language::defaultLanguage = convertLanguag
         { GW2_SCT::LanguageKey::Add_Filter_Button_Text, "Add Filter" },
         { GW2_SCT::LanguageKey::Used_By_Label, "Used by:" },
         { GW2_SCT::LanguageKey::Not_Assigned_Info, "Not assigned to any receivers" },
+        { GW2_SCT::LanguageKey::Filter_Cache_Hit_Rate, "Cached filter verdicts: %.1f%% of %llu lookups" },
         { GW2_SCT::LanguageKey::Select_Filter_Set_Hint_Line1, "Select a filter set from the list on the left, or create a new one." },
         { GW2_SCT::LanguageKey::Select_Filter_Set_Hint_Line2, "Filter sets control which skills are shown or hidden in scroll areas." },
     } },
@@ -1,29 +1,51 @@
 #include "Message.h"
-#include <iostream>
-#include <sstream>
 #include <algorithm>
-#include <cstring>
+#include <cctype>
 #include <cstdlib>
-#include "Language.h"
-#include "Options.h"
-#include "Common.h"
+#include "NumberFormat.h"
+#include "TemplateParser.h"
 
 #define COMBINE_FUNCTION(NAME) \
-    std::function<bool(const GW2_SCT::DataVecView&, const GW2_SCT::DataVecView&)> NAME = \
-    [](const GW2_SCT::DataVecView& srcData, const GW2_SCT::DataVecView& targetData)
+    static bool NAME(const GW2_SCT::MessageData& srcData, const GW2_SCT::MessageData& targetData)
 
 #define PARAMETER_FUNCTION(NAME) \
-    std::function<std::string(const GW2_SCT::DataVecView&)> NAME = \
-    [](const GW2_SCT::DataVecView& data)
+    static void NAME(const GW2_SCT::MessageAggregate& data, [[maybe_unused]] const GW2_SCT::MessageRenderOptions& options, std::string& out)
 
 namespace {
-    thread_local bool GW2_SCT_fmt_abbrevSkill = false;
-    thread_local int  GW2_SCT_fmt_numberPrecision = -1;
-    inline std::string GW2_SCT_fmt_number(int32_t v) {
-        if (GW2_SCT_fmt_numberPrecision >= 0) {
-            return ::ShortenNumber(static_cast<double>(v), GW2_SCT_fmt_numberPrecision);
+    inline void GW2_SCT_fmt_number(std::string& out, int32_t v, const GW2_SCT::MessageRenderOptions& options) {
+        GW2_SCT::NumberBuffer buffer;
+        if (options.numberShortPrecision >= 0) {
+            out += GW2_SCT::FormatNumber(buffer, static_cast<double>(v), options.numberShortPrecision, options.numberFormat);
+            return;
+        }
+        out += GW2_SCT::FormatInteger(buffer, v, options.numberFormat);
+    }
+}
+
+std::string AbbreviateSkillName(const std::string& skillName) {
+    std::string result;
+    AppendAbbreviatedSkillName(result, skillName);
+    return result;
+}
+
+void AppendAbbreviatedSkillName(std::string& out, std::string_view skillName) {
+    if (skillName.find_first_of(" -") == std::string_view::npos) {
+        out += skillName;
+        return;
+    }
+
+    bool nextIsFirst = true;
+
+    for (char c : skillName) {
+        if (std::isalpha(c)) {
+            if (nextIsFirst) {
+                out += c;
+                nextIsFirst = false;
+            }
+        }
+        else if (c == ' ' || c == '-') {
+            nextIsFirst = true;
         }
-        return std::to_string(v);
     }
 }
 
@@ -31,186 +53,104 @@ namespace GW2_SCT {
 
 
     COMBINE_FUNCTION(combineFunctionSkillId) {
-        if (!srcData.empty() && !targetData.empty()) {
-            return srcData.front()->skillId == targetData.front()->skillId;
-        }
-        return false;
-    };
+        return srcData.skillId == targetData.skillId;
+    }
 
     COMBINE_FUNCTION(combineFunctionEntityId) {
-        if (!srcData.empty() && !targetData.empty()) {
-            return srcData.front()->entityId == targetData.front()->entityId;
-        }
-        return false;
-    };
+        return srcData.entityId == targetData.entityId;
+    }
 
     COMBINE_FUNCTION(combineFunctionOtherEntityId) {
-        if (!srcData.empty() && !targetData.empty()) {
-            return srcData.front()->otherEntityId == targetData.front()->otherEntityId;
-        }
-        return false;
-    };
+        return srcData.otherEntityId == targetData.otherEntityId;
+    }
 
 
     PARAMETER_FUNCTION(parameterFunctionValue) {
-        int32_t value = 0;
-        for (auto& i : data) value += i->value;
-        return GW2_SCT_fmt_number(value);
-    };
+        GW2_SCT_fmt_number(out, data.value, options);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionBuffValue) {
-        int32_t value = 0;
-        for (auto& i : data) value += i->buffValue;
-        return GW2_SCT_fmt_number(value);
-    };
+        GW2_SCT_fmt_number(out, data.buffValue, options);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionNegativeValue) {
-        int32_t value = 0;
-        for (auto& i : data) value -= i->value;
-        return GW2_SCT_fmt_number(value);
-    };
+        GW2_SCT_fmt_number(out, -data.value, options);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionOverstackValue) {
-        int32_t value = 0;
-        for (auto& i : data) value += i->overstack_value;
-        return GW2_SCT_fmt_number(value);
-    };
+        GW2_SCT_fmt_number(out, data.overstackValue, options);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionNegativeBuffValue) {
-        int32_t value = 0;
-        for (auto& i : data) value -= i->buffValue;
-        return GW2_SCT_fmt_number(value);
-    };
+        GW2_SCT_fmt_number(out, -data.buffValue, options);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionOverstackBuffValue) {
-        int32_t value = 0;
-        for (auto& i : data) value += i->overstack_value;
-        return GW2_SCT_fmt_number(value);
-    };
+        GW2_SCT_fmt_number(out, data.overstackValue, options);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionEntityName) {
-        if (data.size() > 1) {
-            std::string ret = data.front()->entityName ? std::string(data.front()->entityName) : std::string();
-            for (auto& temp : data) {
-                if (!temp->entityName || std::strcmp(temp->entityName, ret.c_str()) != 0) {
-                    ret = std::string(langString(LanguageCategory::Message, LanguageKey::Multiple_Sources));
-                    break;
-                }
-            }
-            return ret;
+        if (!data.first) return;
+        if (!data.entityNameUniform) {
+            out += options.text(MessageText::MULTIPLE_SOURCES);
+            return;
         }
-        if (data.size() == 1 && data.front()->entityName != nullptr) {
-            return std::string(data.front()->entityName);
-        }
-        return std::string("");
-    };
+        out += StringInterner::view(data.first->entityName);
+    }
 
     PARAMETER_FUNCTION(parameterFunctionOtherEntityName) {
-        if (!data.empty() && data.front()->otherEntityName != nullptr) {
-            return std::string(data.front()->otherEntityName);
+        if (data.first) {
+            out += StringInterner::view(data.first->otherEntityName);
         }
-        return std::string("");
-    };
+    }
 
     PARAMETER_FUNCTION(parameterFunctionSkillName) {
-        if (!data.empty() && data.front()->skillName != nullptr) {
-            std::string s = std::string(data.front()->skillName);
-            if (GW2_SCT_fmt_abbrevSkill) s = AbbreviateSkillName(s);
-            return s;
+        if (data.first && data.first->skillName != 0) {
+            std::string_view skillName = StringInterner::view(data.first->skillName);
+            if (options.abbreviateSkillNames) AppendAbbreviatedSkillName(out, skillName);
+            else out += skillName;
         }
-        return std::string("");
-    };
+    }
 
     PARAMETER_FUNCTION(parameterFunctionSkillIcon) {
-        if (Options::get()->skillIconsEnabled && !data.empty()) {
-            return std::string("[icon=" + std::to_string(data.front()->skillId) + "][/icon]");
+        if (options.skillIconsEnabled && data.first) {
+            NumberBuffer buffer;
+            out += "[icon=";
+            out += FormatInteger(buffer, data.first->skillId);
+            out += "][/icon]";
         }
-        return std::string("");
-    };
+    }
 
     PARAMETER_FUNCTION(parameterFunctionEntityProfessionName) {
-        if (!data.empty()) {
-            std::string professionName;
-            switch (data.front()->entityProf)
-            {
-            case PROFESSION_GUARDIAN:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Guardian));
-                break;
-            case PROFESSION_WARRIOR:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Warrior));
-                break;
-            case PROFESSION_ENGINEER:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Engineer));
-                break;
-            case PROFESSION_RANGER:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Ranger));
-                break;
-            case PROFESSION_THIEF:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Thief));
-                break;
-            case PROFESSION_ELEMENTALIST:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Elementalist));
-                break;
-            case PROFESSION_MESMER:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Mesmer));
-                break;
-            case PROFESSION_NECROMANCER:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Necromancer));
-                break;
-            case PROFESSION_REVENANT:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Revenant));
-                break;
-            default:
-                professionName = std::string(Language::get(LanguageCategory::Option_UI, LanguageKey::Profession_Colors_Undetectable));
-                break;
-            }
-            return professionName;
+        if (data.first) {
+            out += options.professionName(data.first->entityProf);
         }
-        return std::string("");
-    };
+    }
 
     PARAMETER_FUNCTION(parameterFunctionEntityProfessionColor) {
-        std::string professionColor;
-        if (!data.empty()) {
-            switch (data.front()->entityProf) {
-            case PROFESSION_GUARDIAN:    professionColor = Options::get()->professionColorGuardian;    break;
-            case PROFESSION_WARRIOR:     professionColor = Options::get()->professionColorWarrior;     break;
-            case PROFESSION_ENGINEER:    professionColor = Options::get()->professionColorEngineer;    break;
-            case PROFESSION_RANGER:      professionColor = Options::get()->professionColorRanger;      break;
-            case PROFESSION_THIEF:       professionColor = Options::get()->professionColorThief;       break;
-            case PROFESSION_ELEMENTALIST:professionColor = Options::get()->professionColorElementalist; break;
-            case PROFESSION_MESMER:      professionColor = Options::get()->professionColorMesmer;      break;
-            case PROFESSION_NECROMANCER: professionColor = Options::get()->professionColorNecromancer; break;
-            case PROFESSION_REVENANT:    professionColor = Options::get()->professionColorRevenant;    break;
-            default:                     professionColor = Options::get()->professionColorDefault;     break;
-            }
+        if (data.first) {
+            out += options.professionColor(data.first->entityProf);
         }
-        return professionColor;
-    };
+    }
 
     PARAMETER_FUNCTION(parameterFunctionSkillId) {
-        if (!data.empty()) {
-            return std::to_string(data.front()->skillId);
+        if (data.first) {
+            NumberBuffer buffer;
+            out += FormatInteger(buffer, data.first->skillId);
         }
-        return std::string("");
-    };
+    }
 
 
-    static MessageHandler makeOutHandler() {
-        return MessageHandler(
-            { combineFunctionSkillId },
-            {
-                { 'v', parameterFunctionNegativeValue },
-                { 'n', parameterFunctionEntityName },
-                { 's', parameterFunctionSkillName },
-                { 'i', parameterFunctionSkillIcon },
-                { 'd', parameterFunctionSkillId }
-            }
-        );
+    static constexpr MessageHandler makeHandler(std::initializer_list<CombineFunction> combineFunctions, std::initializer_list<std::pair<char, ParameterFunction>> parameterFunctions) {
+        MessageHandler handler;
+        size_t i = 0;
+        for (CombineFunction fn : combineFunctions) handler.combineFunctions[i++] = fn;
+        for (const auto& [parameter, fn] : parameterFunctions) handler.parameterFunctions[static_cast<unsigned char>(parameter)] = fn;
+        return handler;
     }
 
-    static MessageHandler makeOutBuffHandler(std::function<std::string(const DataVecView&)> valFunc) {
-        return MessageHandler(
+    static constexpr MessageHandler makeOutHandler(ParameterFunction valFunc) {
+        return makeHandler(
             { combineFunctionSkillId },
             {
                 { 'v', valFunc },
@@ -222,23 +162,8 @@ namespace GW2_SCT {
         );
     }
 
-    static MessageHandler makeInHandler() {
-        return MessageHandler(
-            { combineFunctionSkillId, combineFunctionEntityId },
-            {
-                { 'v', parameterFunctionNegativeValue },
-                { 'n', parameterFunctionEntityName },
-                { 's', parameterFunctionSkillName },
-                { 'c', parameterFunctionEntityProfessionColor },
-                { 'r', parameterFunctionEntityProfessionName },
-                { 'i', parameterFunctionSkillIcon },
-                { 'd', parameterFunctionSkillId }
-            }
-        );
-    }
-
-    static MessageHandler makeInBuffHandler(std::function<std::string(const DataVecView&)> valFunc) {
-        return MessageHandler(
+    static constexpr MessageHandler makeInHandler(ParameterFunction valFunc) {
+        return makeHandler(
             { combineFunctionSkillId, combineFunctionEntityId },
             {
                 { 'v', valFunc },
@@ -252,221 +177,69 @@ namespace GW2_SCT {
         );
     }
 
-    std::map<MessageCategory, std::map<MessageType, MessageHandler>> EventMessage::messageHandlers = {
-        // --- PLAYER_OUT ---
-        { MessageCategory::PLAYER_OUT, {
-            { MessageType::PHYSICAL,       makeOutHandler() },
-            { MessageType::CRIT,           makeOutHandler() },
-            { MessageType::BLEEDING,       makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::BURNING,        makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::POISON,         makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::CONFUSION,      makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::TORMENT,        makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::DOT,            makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::HEAL,           makeOutBuffHandler(parameterFunctionValue) },
-            { MessageType::HOT,            makeOutBuffHandler(parameterFunctionBuffValue) },
-            { MessageType::SHIELD_RECEIVE, makeOutBuffHandler(parameterFunctionOverstackBuffValue) },
-            { MessageType::SHIELD_REMOVE,  makeOutBuffHandler(parameterFunctionOverstackValue) },
-            { MessageType::BLOCK,          makeOutHandler() },
-            { MessageType::EVADE,          makeOutHandler() },
-            { MessageType::INVULNERABLE,   makeOutHandler() },
-            { MessageType::MISS,           makeOutHandler() }
-        }},
-
-        // --- PLAYER_IN ---
-        { MessageCategory::PLAYER_IN, {
-            { MessageType::PHYSICAL,       makeInHandler() },
-            { MessageType::CRIT,           makeInHandler() },
-            { MessageType::BLEEDING,       makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::BURNING,        makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::POISON,         makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::CONFUSION,      makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::TORMENT,        makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::DOT,            makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::HEAL,           makeInBuffHandler(parameterFunctionValue) },
-            { MessageType::HOT,            makeInBuffHandler(parameterFunctionBuffValue) },
-            { MessageType::SHIELD_RECEIVE, makeInBuffHandler(parameterFunctionOverstackBuffValue) },
-            { MessageType::SHIELD_REMOVE,  makeInBuffHandler(parameterFunctionOverstackValue) },
-            { MessageType::BLOCK,          makeInHandler() },
-            { MessageType::EVADE,          makeInHandler() },
-            { MessageType::INVULNERABLE,   makeInHandler() },
-            { MessageType::MISS,           makeInHandler() }
-        }},
-
-        // --- PET_OUT mirrors PLAYER_OUT ---
-        { MessageCategory::PET_OUT, {
-            { MessageType::PHYSICAL,       makeOutHandler() },
-            { MessageType::CRIT,           makeOutHandler() },
-            { MessageType::BLEEDING,       makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::BURNING,        makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::POISON,         makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::CONFUSION,      makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::TORMENT,        makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::DOT,            makeOutBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::HEAL,           makeOutBuffHandler(parameterFunctionValue) },
-            { MessageType::HOT,            makeOutBuffHandler(parameterFunctionBuffValue) },
-            { MessageType::SHIELD_RECEIVE, makeOutBuffHandler(parameterFunctionOverstackBuffValue) },
-            { MessageType::SHIELD_REMOVE,  makeOutBuffHandler(parameterFunctionOverstackValue) },
-            { MessageType::BLOCK,          makeOutHandler() },
-            { MessageType::EVADE,          makeOutHandler() },
-            { MessageType::INVULNERABLE,   makeOutHandler() },
-            { MessageType::MISS,           makeOutHandler() }
-        }},
-
-        // --- PET_IN mirrors PLAYER_IN ---
-        { MessageCategory::PET_IN, {
-            { MessageType::PHYSICAL,       makeInHandler() },
-            { MessageType::CRIT,           makeInHandler() },
-            { MessageType::BLEEDING,       makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::BURNING,        makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::POISON,         makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::CONFUSION,      makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::TORMENT,        makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::DOT,            makeInBuffHandler(parameterFunctionNegativeBuffValue) },
-            { MessageType::HEAL,           makeInBuffHandler(parameterFunctionValue) },
-            { MessageType::HOT,            makeInBuffHandler(parameterFunctionBuffValue) },
-            { MessageType::SHIELD_RECEIVE, makeInBuffHandler(parameterFunctionOverstackBuffValue) },
-            { MessageType::SHIELD_REMOVE,  makeInBuffHandler(parameterFunctionOverstackValue) },
-            { MessageType::BLOCK,          makeInHandler() },
-            { MessageType::EVADE,          makeInHandler() },
-            { MessageType::INVULNERABLE,   makeInHandler() },
-            { MessageType::MISS,           makeInHandler() }
-        }}
+    // Handlers differ only by direction and by the value shown for 'v'
+    struct HandlerSet {
+        MessageHandler negativeValue, negativeBuffValue, value, buffValue, overstackBuffValue, overstackValue;
     };
 
-    MessageHandler::MessageHandler(
-        std::vector<std::function<bool(const DataVecView&, const DataVecView&)>> tryToCombineWithFunctions,
-        std::map<char, std::function<std::string(const DataVecView&)>> parameterToStringFunctions
-    ) : tryToCombineWithFunctions(std::move(tryToCombineWithFunctions)),
-        parameterToStringFunctions(std::move(parameterToStringFunctions)) {
-    }
-
-    EventMessage::EventMessage(MessageCategory category, MessageType type, cbtevent* ev, ag* src, ag* dst, char* skillname)
-        : category(category), type(type), timepoint(std::chrono::system_clock::now()) {
-        switch (category) {
-        case MessageCategory::PLAYER_OUT:
-        case MessageCategory::PET_OUT:
-            messageDatas.push_back(std::make_shared<MessageData>(ev, dst, src, skillname));
-            break;
-        case MessageCategory::PLAYER_IN:
-        case MessageCategory::PET_IN:
-            messageDatas.push_back(std::make_shared<MessageData>(ev, src, dst, skillname));
-            break;
-        default:
-            LOG("GW2_SCT: Received message for unknown category.");
-            break;
-        }
-    }
-
-    EventMessage::EventMessage(MessageCategory category, MessageType type, cbtevent1* ev, ag* src, ag* dst, char* skillname)
-        : category(category), type(type), timepoint(std::chrono::system_clock::now()) {
-        switch (category) {
-        case MessageCategory::PLAYER_OUT:
-        case MessageCategory::PET_OUT:
-            messageDatas.push_back(std::make_shared<MessageData>(ev, dst, src, skillname));
-            break;
-        case MessageCategory::PLAYER_IN:
-        case MessageCategory::PET_IN:
-            messageDatas.push_back(std::make_shared<MessageData>(ev, src, dst, skillname));
-            break;
-        default:
-            LOG("GW2_SCT: Received message for unknown category.");
-            break;
-        }
+    static constexpr HandlerSet makeHandlerSet(MessageHandler(*make)(ParameterFunction)) {
+        return {
+            make(parameterFunctionNegativeValue),
+            make(parameterFunctionNegativeBuffValue),
+            make(parameterFunctionValue),
+            make(parameterFunctionBuffValue),
+            make(parameterFunctionOverstackBuffValue),
+            make(parameterFunctionOverstackValue)
+        };
     }
 
-    EventMessage::EventMessage(MessageCategory category, MessageType type, std::shared_ptr<MessageData> data)
-        : category(category), type(type), timepoint(std::chrono::system_clock::now()) {
-        messageDatas.push_back(std::make_shared<MessageData>(*data));
+    static constexpr HandlerSet outHandlers = makeHandlerSet(makeOutHandler);
+    static constexpr HandlerSet inHandlers = makeHandlerSet(makeInHandler);
+
+    static constexpr std::array<const MessageHandler*, NUM_MESSAGE_TYPES> makeTypeTable(const HandlerSet& handlers) {
+        std::array<const MessageHandler*, NUM_MESSAGE_TYPES> table = {};
+        table[static_cast<int>(MessageType::PHYSICAL)] = &handlers.negativeValue;
+        table[static_cast<int>(MessageType::CRIT)] = &handlers.negativeValue;
+        table[static_cast<int>(MessageType::BLEEDING)] = &handlers.negativeBuffValue;
+        table[static_cast<int>(MessageType::BURNING)] = &handlers.negativeBuffValue;
+        table[static_cast<int>(MessageType::POISON)] = &handlers.negativeBuffValue;
+        table[static_cast<int>(MessageType::CONFUSION)] = &handlers.negativeBuffValue;
+        table[static_cast<int>(MessageType::TORMENT)] = &handlers.negativeBuffValue;
+        table[static_cast<int>(MessageType::DOT)] = &handlers.negativeBuffValue;
+        table[static_cast<int>(MessageType::HEAL)] = &handlers.value;
+        table[static_cast<int>(MessageType::HOT)] = &handlers.buffValue;
+        table[static_cast<int>(MessageType::SHIELD_RECEIVE)] = &handlers.overstackBuffValue;
+        table[static_cast<int>(MessageType::SHIELD_REMOVE)] = &handlers.overstackValue;
+        table[static_cast<int>(MessageType::BLOCK)] = &handlers.negativeValue;
+        table[static_cast<int>(MessageType::EVADE)] = &handlers.negativeValue;
+        table[static_cast<int>(MessageType::INVULNERABLE)] = &handlers.negativeValue;
+        table[static_cast<int>(MessageType::MISS)] = &handlers.negativeValue;
+        return table;
     }
 
-    std::string EventMessage::getStringForOptions(std::shared_ptr<message_receiver_options_struct> opt) {
-        if (!opt) return "";
-
-        if (messageDatas.empty()) {
-            LOG("WARN: empty message");
-            return "";
-        }
-
-        messageDatas.erase(
-            std::remove_if(messageDatas.begin(), messageDatas.end(),
-                [](const std::shared_ptr<MessageData>& p) { return !p; }),
-            messageDatas.end()
-        );
-
-        DataVecView view;
-        view.reserve(messageDatas.size());
-        for (auto& sp : messageDatas) view.push_back(sp);
-
-        bool prevAbbrev = GW2_SCT_fmt_abbrevSkill;
-        int  prevPrec = GW2_SCT_fmt_numberPrecision;
-        GW2_SCT_fmt_abbrevSkill = opt->transient_abbreviateSkillNames;
-        GW2_SCT_fmt_numberPrecision = opt->transient_numberShortPrecision;
-
-        std::string outputTemplate = opt->outputTemplate;
-        std::stringstream stm;
-        stm << "[col=" << opt->color << "]";
-        for (auto it = outputTemplate.begin(); it != outputTemplate.end(); ++it) {
-            switch (*it) {
-            case '%':
-                ++it;
-                if (it != outputTemplate.end() && *it == '%') {
-                    stm << *it;
-                }
-                else if (it != outputTemplate.end()) {
-                    auto cat = messageHandlers.find(category);
-                    if (cat != messageHandlers.end()) {
-                        auto typ = cat->second.find(type);
-                        if (typ != cat->second.end()) {
-                            auto pf = typ->second.parameterToStringFunctions.find(*it);
-                            if (pf != typ->second.parameterToStringFunctions.end()) {
-                                stm << pf->second(view);
-                            }
-                        }
-                    }
-                }
-                break;
-            default:
-                stm << *it;
-                break;
-            }
-        }
-
-        if (messageDatas.size() > 1) {
-            if (opt->transient_showCombinedHitCount) {
-                stm << " [[" << messageDatas.size() << " "
-                    << langString(LanguageCategory::Message, LanguageKey::Number_Of_Hits) << "]]";
-            }
-        }
-
-        stm << "[/col]";
-
-        GW2_SCT_fmt_abbrevSkill = prevAbbrev;
-        GW2_SCT_fmt_numberPrecision = prevPrec;
-
-        return stm.str();
-    }
+    // Indexed by [category][type], pets mirror the player; nullptr for MessageType::NONE
+    static constexpr std::array<std::array<const MessageHandler*, NUM_MESSAGE_TYPES>, NUM_CATEGORIES> messageHandlers = {
+        makeTypeTable(outHandlers), // PLAYER_OUT
+        makeTypeTable(inHandlers),  // PLAYER_IN
+        makeTypeTable(outHandlers), // PET_OUT
+        makeTypeTable(inHandlers)   // PET_IN
+    };
 
-    std::shared_ptr<MessageData> EventMessage::getCopyOfFirstData() {
-        if (!messageDatas.empty() && messageDatas.front()) {
-            return std::make_shared<MessageData>(*messageDatas.front());
-        }
-        return {};
+    static const MessageHandler* getMessageHandler(MessageCategory category, MessageType type) {
+        size_t c = static_cast<size_t>(category);
+        size_t t = static_cast<size_t>(type);
+        if (c >= NUM_CATEGORIES || t >= NUM_MESSAGE_TYPES) return nullptr;
+        return messageHandlers[c][t];
     }
 
-    int32_t EventMessage::getCombinedValue() const {
-        MessageType msgType = type;
-        int32_t totalValue = 0;
-        
-        switch (msgType) {
+    // Magnitude of a single payload as used by thresholds and the overload modes
+    static int32_t combinedValueOf(MessageType type, const MessageData& data) {
+        switch (type) {
             case MessageType::PHYSICAL:
             case MessageType::CRIT:
             case MessageType::HEAL:
-                for (auto& data : messageDatas) {
-                    if (data) totalValue += abs(data->value);
-                }
-                break;
-                
+                return abs(data.value);
+
             case MessageType::BLEEDING:
             case MessageType::BURNING:
             case MessageType::POISON:
@@ -474,159 +247,190 @@ namespace GW2_SCT {
             case MessageType::TORMENT:
             case MessageType::DOT:
             case MessageType::HOT:
-                for (auto& data : messageDatas) {
-                    if (data) totalValue += abs(data->buffValue);
-                }
-                break;
-                
+                return abs(data.buffValue);
+
             case MessageType::SHIELD_RECEIVE:
             case MessageType::SHIELD_REMOVE:
-                for (auto& data : messageDatas) {
-                    if (data) {
-                        if (data->overstack_value != 0) {
-                            totalValue += abs(static_cast<int32_t>(data->overstack_value));
-                        } else {
-                            totalValue += abs(data->value);
-                        }
-                    }
+                if (data.overstack_value != 0) {
+                    return abs(static_cast<int32_t>(data.overstack_value));
                 }
-                break;
-                
+                return abs(data.value);
+
             default:
                 // For other types, try to get any non-zero value
-                for (auto& data : messageDatas) {
-                    if (data) {
-                        if (data->value != 0) {
-                            totalValue += abs(data->value);
-                        } else if (data->buffValue != 0) {
-                            totalValue += abs(data->buffValue);
-                        } else {
-                            totalValue += abs(static_cast<int32_t>(data->overstack_value));
-                        }
-                    }
-                }
-                break;
+                if (data.value != 0) return abs(data.value);
+                if (data.buffValue != 0) return abs(data.buffValue);
+                return abs(static_cast<int32_t>(data.overstack_value));
         }
-        
-        return totalValue;
     }
 
-    MessageCategory EventMessage::getCategory() { return category; }
-    MessageType     EventMessage::getType() { return type; }
-    bool            EventMessage::hasToBeFiltered() { return false; }
-    std::chrono::system_clock::time_point EventMessage::getTimepoint() { return timepoint; }
-
-    bool EventMessage::tryToCombineWith(std::shared_ptr<EventMessage> m) {
-        if (!m) return false;
-        if (m->category != category || m->type != type) return false;
+    void MessageAggregate::add(MessageType type, const MessageData& data) {
+        value += data.value;
+        buffValue += data.buffValue;
+        overstackValue += data.overstack_value;
+        combinedValue += combinedValueOf(type, data);
+        hitCount += data.hitCount;
+        if (first && data.entityName != first->entityName) entityNameUniform = false;
+    }
 
-        auto cat = messageHandlers.find(category);
-        if (cat == messageHandlers.end()) return false;
-        auto typ = cat->second.find(type);
-        if (typ == cat->second.end()) return false;
+    EventMessage::EventMessage(MessageCategory category, MessageType type, std::shared_ptr<const MessageData> data, std::chrono::system_clock::time_point timepoint)
+        : category(category), type(type), timepoint(timepoint) {
+        if (data) {
+            aggregate.add(type, *data);
+            aggregate.first = std::move(data);
+        }
+    }
 
-        DataVecView a, b;
-        a.reserve(messageDatas.size());
-        for (auto& sp : messageDatas) a.push_back(sp);
-        b.reserve(m->messageDatas.size());
-        for (auto& sp : m->messageDatas) b.push_back(sp);
+    std::shared_ptr<const CompiledTemplate> CompiledTemplate::compile(const std::string& outputTemplate, const std::string& color, MessageCategory category, MessageType type) {
+        auto compiled = std::make_shared<CompiledTemplate>();
+        const MessageHandler* handler = getMessageHandler(category, type);
 
-        for (auto& fn : typ->second.tryToCombineWithFunctions) {
-            if (!fn(a, b)) return false;
+        // Consecutive literal text is appended to the last op instead of starting a new one
+        auto appendLiteral = [&compiled](std::string_view literal) {
+            if (literal.empty()) return;
+            if (compiled->ops.empty() || compiled->ops.back().code != OpCode::LITERAL) {
+                compiled->ops.push_back({ OpCode::LITERAL, static_cast<uint32_t>(compiled->text.size()), 0, nullptr });
+            }
+            compiled->text += literal;
+            compiled->ops.back().length += static_cast<uint32_t>(literal.size());
+        };
+
+        appendLiteral("[col=");
+        appendLiteral(color);
+        appendLiteral("]");
+        auto appendParameter = [&compiled, handler](char parameter) {
+            if (handler == nullptr) return;
+            ParameterFunction parameterFunction = handler->parameterFunctions[static_cast<unsigned char>(parameter)];
+            if (parameterFunction == parameterFunctionSkillIcon) {
+                compiled->ops.push_back({ OpCode::ICON });
+            }
+            else if (parameterFunction != nullptr) {
+                compiled->ops.push_back({ OpCode::PARAMETER, 0, 0, parameterFunction });
+            }
+        };
+
+        TemplateParseResult parsed = TemplateParser::parse(outputTemplate, TemplateSyntax::TEMPLATE);
+        if (!parsed.valid()) {
+            // Renders as invalid markup, which the interpreter shows as nothing, like before templates were parsed
+            compiled->error = parsed.error;
+            compiled->errorPosition = parsed.errorPosition;
+            appendLiteral(outputTemplate);
+            parsed.nodes.clear();
         }
-
-        for (auto& src : m->messageDatas) {
-            if (src) messageDatas.push_back(std::make_shared<MessageData>(*src));
+        for (const TemplateNode& node : parsed.nodes) {
+            switch (node.type) {
+            case TemplateNode::Type::TEXT:
+                // Text is unescaped by the parser, brackets have to be doubled again for the interpreter
+                for (char c : node.text) {
+                    if (c == '[' || c == ']') appendLiteral(std::string_view(&c, 1));
+                    appendLiteral(std::string_view(&c, 1));
+                }
+                break;
+            case TemplateNode::Type::PARAMETER:
+                appendParameter(node.parameter);
+                break;
+            case TemplateNode::Type::COLOR_BEGIN:
+                appendLiteral("[col=");
+                if (node.parameter != 0) appendParameter(node.parameter);
+                else appendLiteral(node.text);
+                appendLiteral("]");
+                break;
+            case TemplateNode::Type::COLOR_END:
+                appendLiteral("[/col]");
+                break;
+            case TemplateNode::Type::ICON_BEGIN:
+                appendLiteral("[icon=");
+                appendLiteral(node.text);
+                appendLiteral("]");
+                break;
+            case TemplateNode::Type::ICON_END:
+                appendLiteral("[/icon]");
+                break;
+            }
         }
-        return true;
+        compiled->ops.push_back({ OpCode::HIT_COUNT });
+        appendLiteral("[/col]");
+        return compiled;
     }
 
-    namespace {
-        inline char* dup_cstr(const char* s) {
-            if (!s) return nullptr;
-            size_t n = std::strlen(s) + 1;
-            char* p = static_cast<char*>(std::malloc(n));
-            if (p) std::memcpy(p, s, n);
-            return p;
+    void EventMessage::render(const CompiledTemplate& compiled, const MessageRenderOptions& options, std::string& out) const {
+        out.clear();
+        if (!aggregate.first) return;
+
+        NumberBuffer numberBuffer;
+        for (const CompiledTemplate::Op& op : compiled.ops) {
+            switch (op.code) {
+            case CompiledTemplate::OpCode::LITERAL:
+                out.append(compiled.text, op.offset, op.length);
+                break;
+            case CompiledTemplate::OpCode::PARAMETER:
+                op.parameter(aggregate, options, out);
+                break;
+            case CompiledTemplate::OpCode::ICON:
+                if (options.skillIconsEnabled) {
+                    out += "[icon=";
+                    out += FormatInteger(numberBuffer, aggregate.first->skillId);
+                    out += "][/icon]";
+                }
+                break;
+            case CompiledTemplate::OpCode::HIT_COUNT:
+                if (aggregate.hitCount > 1 && options.showCombinedHitCount) {
+                    out += " [[";
+                    out += FormatInteger(numberBuffer, aggregate.hitCount);
+                    out += " ";
+                    out += options.text(MessageText::NUMBER_OF_HITS);
+                    out += "]]";
+                }
+                break;
+            }
         }
     }
 
-    MessageData::MessageData(cbtevent* ev, ag* entity, ag* otherEntity, const char* skillname) {
-        skillName = dup_cstr(skillname);
-        value = ev->value;
-        buffValue = ev->buff_dmg;
-        skillId = ev->skillid;
+    uint32_t EventMessage::getHitCount() const {
+        return aggregate.hitCount;
+    }
 
-        if (entity) {
-            entityId = entity->id;
-            entityProf = entity->prof;
-            if (entity->name) entityName = dup_cstr(entity->name);
-        }
-        if (otherEntity) {
-            otherEntityId = otherEntity->id;
-            otherEntityProf = otherEntity->prof;
-            if (otherEntity->name) otherEntityName = dup_cstr(otherEntity->name);
-        }
-        hasToBeFiltered = false;
+    int32_t EventMessage::getCombinedValue() const {
+        return aggregate.combinedValue;
     }
 
-    MessageData::MessageData(cbtevent1* ev, ag* entity, ag* otherEntity, const char* skillname) {
-        skillName = dup_cstr(skillname);
-        value = ev->value;
-        overstack_value = ev->overstack_value;
-        buffValue = ev->buff_dmg;
-        skillId = ev->skillid;
+    MessageCategory EventMessage::getCategory() const { return category; }
+    MessageType     EventMessage::getType() const { return type; }
+    bool            EventMessage::hasToBeFiltered() { return false; }
+    std::chrono::system_clock::time_point EventMessage::getTimepoint() { return timepoint; }
+
+    bool EventMessage::tryToCombineWith(MessageCategory otherCategory, MessageType otherType, const std::shared_ptr<const MessageData>& data) {
+        if (!data || !aggregate.first) return false;
+        if (otherCategory != category || otherType != type) return false;
 
-        if (entity) {
-            entityId = entity->id;
-            entityProf = entity->prof;
-            if (entity->name) entityName = dup_cstr(entity->name);
-        }
-        if (otherEntity) {
-            otherEntityId = otherEntity->id;
-            otherEntityProf = otherEntity->prof;
-            if (otherEntity->name) otherEntityName = dup_cstr(otherEntity->name);
+        const MessageHandler* handler = getMessageHandler(category, type);
+        if (handler == nullptr) return false;
+
+        for (CombineFunction combineFunction : handler->combineFunctions) {
+            if (combineFunction == nullptr) break;
+            if (!combineFunction(*aggregate.first, *data)) return false;
         }
-        hasToBeFiltered = false;
+
+        aggregate.add(type, *data);
+        return true;
     }
 
-#ifdef _DEBUG
-    MessageData::MessageData(int32_t value, int32_t buffValue, uint32_t overstack_value, uint32_t skillId,
-        ag* entity, ag* otherEntity, const char* skillname)
-        : value(value), overstack_value(overstack_value), buffValue(buffValue), skillId(skillId) {
-        skillName = dup_cstr(skillname);
-        if (entity) {
-            entityId = entity->id; entityProf = entity->prof;
-            if (entity->name) entityName = dup_cstr(entity->name);
-        }
-        if (otherEntity) {
-            otherEntityId = otherEntity->id; otherEntityProf = otherEntity->prof;
-            if (otherEntity->name) otherEntityName = dup_cstr(otherEntity->name);
-        }
+    MessageData::MessageData(const EventRecord& record, MessageCategory category) {
+        const EventAgent& entity = isIncomingCategory(category) ? record.src : record.dst;
+        const EventAgent& otherEntity = isIncomingCategory(category) ? record.dst : record.src;
+        skillName = record.skillName;
+        entityName = entity.name;
+        otherEntityName = otherEntity.name;
+        value = record.value;
+        overstack_value = record.overstack_value;
+        buffValue = record.buffValue;
+        skillId = record.skillId;
+        entityId = entity.id;
+        entityProf = entity.prof;
+        otherEntityId = otherEntity.id;
+        otherEntityProf = otherEntity.prof;
+        hitCount = record.hitCount;
         hasToBeFiltered = false;
     }
-#endif
-
-    MessageData::MessageData(const MessageData& o) {
-        skillName = dup_cstr(o.skillName);
-        entityName = dup_cstr(o.entityName);
-        otherEntityName = dup_cstr(o.otherEntityName);
-        value = o.value;
-        overstack_value = o.overstack_value;
-        buffValue = o.buffValue;
-        skillId = o.skillId;
-        entityId = o.entityId;
-        entityProf = o.entityProf;
-        otherEntityId = o.otherEntityId;
-        otherEntityProf = o.otherEntityProf;
-        hasToBeFiltered = o.hasToBeFiltered;
-    }
-
-    MessageData::~MessageData() {
-        if (skillName)       std::free(skillName);
-        if (entityName)      std::free(entityName);
-        if (otherEntityName) std::free(otherEntityName);
-        skillName = entityName = otherEntityName = nullptr;
-    }
 
 } // namespace GW2_SCT
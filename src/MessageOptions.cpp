@@ -0,0 +1,59 @@
+#include "Message.h"
+#include "Common.h"
+#include "Language.h"
+#include "Options.h"
+#include "OptionsStructures.h"
+
+namespace {
+    GW2_SCT::LanguageKey professionNameKey(uint32_t prof) {
+        switch (prof) {
+        case PROFESSION_GUARDIAN: return GW2_SCT::LanguageKey::Profession_Colors_Guardian;
+        case PROFESSION_WARRIOR: return GW2_SCT::LanguageKey::Profession_Colors_Warrior;
+        case PROFESSION_ENGINEER: return GW2_SCT::LanguageKey::Profession_Colors_Engineer;
+        case PROFESSION_RANGER: return GW2_SCT::LanguageKey::Profession_Colors_Ranger;
+        case PROFESSION_THIEF: return GW2_SCT::LanguageKey::Profession_Colors_Thief;
+        case PROFESSION_ELEMENTALIST: return GW2_SCT::LanguageKey::Profession_Colors_Elementalist;
+        case PROFESSION_MESMER: return GW2_SCT::LanguageKey::Profession_Colors_Mesmer;
+        case PROFESSION_NECROMANCER: return GW2_SCT::LanguageKey::Profession_Colors_Necromancer;
+        case PROFESSION_REVENANT: return GW2_SCT::LanguageKey::Profession_Colors_Revenant;
+        default: return GW2_SCT::LanguageKey::Profession_Colors_Undetectable;
+        }
+    }
+
+    const char* messageText(GW2_SCT::MessageText text) {
+        switch (text) {
+        case GW2_SCT::MessageText::MULTIPLE_SOURCES: return langString(GW2_SCT::LanguageCategory::Message, GW2_SCT::LanguageKey::Multiple_Sources);
+        default: return langString(GW2_SCT::LanguageCategory::Message, GW2_SCT::LanguageKey::Number_Of_Hits);
+        }
+    }
+
+    const char* professionName(uint32_t prof) {
+        return langString(GW2_SCT::LanguageCategory::Option_UI, professionNameKey(prof));
+    }
+
+    const char* professionColor(uint32_t prof) {
+        return GW2_SCT::Options::hot().professionColor(prof);
+    }
+}
+
+void GW2_SCT::EventMessage::writeStringForOptions(const std::shared_ptr<message_receiver_options_struct>& opt, std::string& out) {
+    out.clear();
+    if (!opt) return;
+
+    if (getFirstData() == nullptr) {
+        LOG("WARN: empty message");
+        return;
+    }
+
+    const HotOptions& hot = Options::hot();
+    MessageRenderOptions options;
+    options.numberFormat = hot.numberFormat;
+    options.skillIconsEnabled = hot.skillIconsEnabled;
+    options.abbreviateSkillNames = opt->transient_abbreviateSkillNames;
+    options.numberShortPrecision = opt->transient_numberShortPrecision;
+    options.showCombinedHitCount = opt->transient_showCombinedHitCount;
+    options.text = messageText;
+    options.professionName = professionName;
+    options.professionColor = professionColor;
+    render(*opt->getCompiledTemplate(category, type), options, out);
+}
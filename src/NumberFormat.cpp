@@ -0,0 +1,82 @@
+#include "NumberFormat.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace {
+	// Copies a plain "-1234.5" number into buffer with the format's separators and the suffix appended.
+	// Returns an empty view if the result does not fit.
+	std::string_view localize(GW2_SCT::NumberBuffer& buffer, std::string_view plain, std::string_view suffix, GW2_SCT::NumberFormat format) {
+		size_t sign = (!plain.empty() && plain.front() == '-') ? 1 : 0;
+		size_t dot = plain.find('.');
+		if (dot == std::string_view::npos) dot = plain.size();
+		size_t integerDigits = dot - sign;
+		size_t groups = (format.groupSeparator != '\0' && integerDigits > 0) ? (integerDigits - 1) / 3 : 0;
+		if (plain.size() + groups + suffix.size() > GW2_SCT::NumberBufferSize) return {};
+
+		char* out = buffer;
+		if (sign) *out++ = '-';
+		for (size_t i = 0; i < integerDigits; i++) {
+			if (groups > 0 && i > 0 && (integerDigits - i) % 3 == 0) *out++ = format.groupSeparator;
+			*out++ = plain[sign + i];
+		}
+		if (dot < plain.size()) {
+			*out++ = format.decimalSeparator;
+			out = std::copy(plain.begin() + dot + 1, plain.end(), out);
+		}
+		out = std::copy(suffix.begin(), suffix.end(), out);
+		return std::string_view(buffer, out - buffer);
+	}
+
+	std::string_view writeScientific(GW2_SCT::NumberBuffer& buffer, double number) {
+		auto result = std::to_chars(buffer, buffer + GW2_SCT::NumberBufferSize, number, std::chars_format::scientific, 3);
+		return std::string_view(buffer, result.ptr - buffer);
+	}
+}
+
+std::string_view GW2_SCT::FormatInteger(NumberBuffer& buffer, int64_t number, NumberFormat format) {
+	if (format.groupSeparator == '\0') {
+		auto result = std::to_chars(buffer, buffer + NumberBufferSize, number);
+		return std::string_view(buffer, result.ptr - buffer);
+	}
+	char plain[NumberBufferSize];
+	auto result = std::to_chars(plain, plain + sizeof(plain), number);
+	return localize(buffer, std::string_view(plain, result.ptr - plain), {}, format);
+}
+
+std::string_view GW2_SCT::FormatNumber(NumberBuffer& buffer, double number, int precision, NumberFormat format) {
+	if (std::isnan(number) || std::isinf(number) || number < 0) {
+		buffer[0] = '0';
+		return std::string_view(buffer, 1);
+	}
+	if (precision == -1) {
+		if (number >= 9.2e18) return writeScientific(buffer, number);
+		return FormatInteger(buffer, static_cast<long long>(std::round(number)), format);
+	}
+
+	precision = std::max(0, std::min(3, precision));
+
+	double value = number;
+	std::string_view suffix;
+	if (number >= 1e12) { value = number / 1e12; suffix = "T"; }
+	else if (number >= 1e9) { value = number / 1e9; suffix = "B"; }
+	else if (number >= 1e6) { value = number / 1e6; suffix = "M"; }
+	else if (number >= 1e3) { value = number / 1e3; suffix = "k"; }
+	else if (precision == 0) {
+		return FormatInteger(buffer, static_cast<int>(std::round(number)), format);
+	}
+
+	char plain[NumberBufferSize];
+	auto result = std::to_chars(plain, plain + sizeof(plain), value, std::chars_format::fixed, precision);
+	if (result.ec != std::errc()) return writeScientific(buffer, number);
+	std::string_view digits(plain, result.ptr - plain);
+	// Drop trailing zeros of the decimals, and the point itself if nothing is left after it
+	if (digits.find('.') != std::string_view::npos) {
+		digits = digits.substr(0, digits.find_last_not_of('0') + 1);
+		if (digits.back() == '.') digits.remove_suffix(1);
+	}
+
+	std::string_view written = localize(buffer, digits, suffix, format);
+	if (written.empty()) return writeScientific(buffer, number);
+	return written;
+}
@@ -17,12 +17,16 @@
 #include "ScrollArea.h"
 #include "Profiles.h"
 #include "SkillFilterUI.h"
+#include "OverloadStats.h"
+#include "QuadBatch.h"
 
 const char* TextAlignTexts[] = { langStringG(GW2_SCT::LanguageKey::Text_Align_Left), langStringG(GW2_SCT::LanguageKey::Text_Align_Center), langStringG(GW2_SCT::LanguageKey::Text_Align_Right) };
 const char* TextCurveTexts[] = { langStringG(GW2_SCT::LanguageKey::Text_Curve_Left), langStringG(GW2_SCT::LanguageKey::Text_Curve_Straight), langStringG(GW2_SCT::LanguageKey::Text_Curve_Right), langStringG(GW2_SCT::LanguageKey::Text_Curve_Static), langStringG(GW2_SCT::LanguageKey::Text_Curve_Angled) };
 const char* ScrollDirectionTexts[] = { "Down", "Up" };
 
 GW2_SCT::options_struct GW2_SCT::Options::options;
+GW2_SCT::HotOptions GW2_SCT::Options::uiHotOptions;
+std::atomic<uint32_t> GW2_SCT::Options::combatHotBits = 0;
 bool GW2_SCT::Options::windowIsOpen = false;
 std::string GW2_SCT::Options::fontSelectionString = "";
 std::string GW2_SCT::Options::fontSelectionStringWithMaster = "";
@@ -44,6 +48,57 @@ const std::shared_ptr<GW2_SCT::profile_options_struct> GW2_SCT::Options::get() {
 	return Profiles::get();
 }
 
+namespace {
+	void copyColor(GW2_SCT::HotOptions::Color& target, const std::string& color) {
+		size_t length = std::min(color.size(), target.size() - 1);
+		std::copy_n(color.begin(), length, target.begin());
+		std::fill(target.begin() + length, target.end(), '\0');
+	}
+}
+
+void GW2_SCT::Options::publishHotOptions() {
+	std::shared_ptr<profile_options_struct> profile = get();
+	if (!profile) return;
+
+	HotOptions next;
+	next.sctEnabled = profile->sctEnabled;
+	next.selfMessageOnlyIncoming = profile->selfMessageOnlyIncoming;
+	next.outgoingOnlyToTarget = profile->outgoingOnlyToTarget;
+	next.coalesceIngestedEvents = profile->coalesceIngestedEvents;
+	next.overloadMode = profile->overloadMode;
+	next.overloadQueueDepth = profile->overloadQueueDepth;
+	next.overloadFrameBudgetMs = profile->overloadFrameBudgetMs;
+	next.numberFormat = numberFormatOf(profile->numberFormatStyle);
+	next.combineAllMessages = profile->combineAllMessages;
+	next.dropShadow = profile->dropShadow;
+	next.skillIconsEnabled = profile->skillIconsEnabled;
+	next.messagesInStack = profile->messagesInStack;
+	next.scrollSpeed = profile->scrollSpeed;
+	next.globalOpacity = profile->globalOpacity;
+	next.defaultFontSize = profile->defaultFontSize;
+	next.defaultCritFontSize = profile->defaultCritFontSize;
+	next.globalThresholdsEnabled = profile->globalThresholdsEnabled;
+	next.globalThresholdRespectFilters = profile->globalThresholdRespectFilters;
+	next.globalDamageThreshold = profile->globalDamageThreshold;
+	next.globalHealThreshold = profile->globalHealThreshold;
+	next.globalAbsorbThreshold = profile->globalAbsorbThreshold;
+	copyColor(next.professionColors[PROFESSION_UNDEFINED], profile->professionColorDefault);
+	copyColor(next.professionColors[PROFESSION_GUARDIAN], profile->professionColorGuardian);
+	copyColor(next.professionColors[PROFESSION_WARRIOR], profile->professionColorWarrior);
+	copyColor(next.professionColors[PROFESSION_ENGINEER], profile->professionColorEngineer);
+	copyColor(next.professionColors[PROFESSION_RANGER], profile->professionColorRanger);
+	copyColor(next.professionColors[PROFESSION_THIEF], profile->professionColorThief);
+	copyColor(next.professionColors[PROFESSION_ELEMENTALIST], profile->professionColorElementalist);
+	copyColor(next.professionColors[PROFESSION_MESMER], profile->professionColorMesmer);
+	copyColor(next.professionColors[PROFESSION_NECROMANCER], profile->professionColorNecromancer);
+	copyColor(next.professionColors[PROFESSION_REVENANT], profile->professionColorRevenant);
+
+	if (next == uiHotOptions) return;
+	uiHotOptions = next;
+	// Both flags are read independently of anything else, so one relaxed word is enough to never see them torn
+	combatHotBits.store((next.selfMessageOnlyIncoming ? COMBAT_SELF_MESSAGE_ONLY_INCOMING : 0) | (next.outgoingOnlyToTarget ? COMBAT_OUTGOING_ONLY_TO_TARGET : 0), std::memory_order_relaxed);
+}
+
 std::string GW2_SCT::Options::getCurrentCharacterName() {
 	return Profiles::getCurrentCharacterName();
 }
@@ -186,6 +241,20 @@ namespace GW2_SCT {
 		{ MessageType::MISS, std::string(langString(GW2_SCT::LanguageCategory::Option_UI, GW2_SCT::LanguageKey::Messages_Type_Miss)) }
 	};
 
+	const std::map<OverloadMode, std::string> overloadModeNames = {
+		{ OverloadMode::OFF, std::string(langString(GW2_SCT::LanguageCategory::Option_UI, GW2_SCT::LanguageKey::General_Overload_Mode_Off)) },
+		{ OverloadMode::DROP_LOWEST_VALUE, std::string(langString(GW2_SCT::LanguageCategory::Option_UI, GW2_SCT::LanguageKey::General_Overload_Mode_Drop_Lowest)) },
+		{ OverloadMode::DROP_OLDEST, std::string(langString(GW2_SCT::LanguageCategory::Option_UI, GW2_SCT::LanguageKey::General_Overload_Mode_Drop_Oldest)) },
+		{ OverloadMode::COLLAPSE, std::string(langString(GW2_SCT::LanguageCategory::Option_UI, GW2_SCT::LanguageKey::General_Overload_Mode_Collapse)) }
+	};
+	// Shown as examples, so the names need no translation
+	const std::map<NumberFormatStyle, std::string> numberFormatStyleNames = {
+		{ NumberFormatStyle::PLAIN, "1234567.8" },
+		{ NumberFormatStyle::COMMA_GROUPED, "1,234,567.8" },
+		{ NumberFormatStyle::DOT_GROUPED, "1.234.567,8" },
+		{ NumberFormatStyle::SPACE_GROUPED, "1 234 567,8" },
+		{ NumberFormatStyle::DECIMAL_COMMA, "1234567,8" }
+	};
 	const std::map<SkillIconDisplayType, std::string> skillIconsDisplayTypeNames = {
 		{ SkillIconDisplayType::NORMAL, std::string(langString(GW2_SCT::LanguageCategory::Skill_Icons_Option_UI, GW2_SCT::LanguageKey::Skill_Icons_Display_Type_Normal)) },
 		{ SkillIconDisplayType::BLACK_CULLED, std::string(langString(GW2_SCT::LanguageCategory::Skill_Icons_Option_UI, GW2_SCT::LanguageKey::Skill_Icons_Display_Type_Black_Culled)) },
@@ -503,6 +572,25 @@ void GW2_SCT::Options::paintGeneral() {
 		requestSave();
 	}
 
+	if (ImGui::BeginCombo(
+		ImGui::BuildVisibleLabel(langString(LanguageCategory::Option_UI, LanguageKey::General_Number_Format), "number-format-combo").c_str(),
+		numberFormatStyleNames.at(currentProfile->numberFormatStyle).c_str())
+		) {
+		int i = 0;
+		for (auto& numberFormatStyleAndName : numberFormatStyleNames) {
+			if (ImGui::Selectable(ImGui::BuildLabel(numberFormatStyleAndName.second, "number-format-selectable", i).c_str())) {
+				if (currentProfile->numberFormatStyle != numberFormatStyleAndName.first) {
+					currentProfile->numberFormatStyle = numberFormatStyleAndName.first;
+					requestSave();
+				}
+			}
+			i++;
+		}
+		ImGui::EndCombo();
+	}
+	if (ImGui::IsItemHovered())
+		ImGui::SetTooltip(langString(LanguageCategory::Option_UI, LanguageKey::General_Number_Format_Toolip));
+
 	if (ImGui::Checkbox(langString(LanguageCategory::Option_UI, LanguageKey::General_Self_Only_As_Incoming), &currentProfile->selfMessageOnlyIncoming)) {
 		requestSave();
 	}
@@ -514,6 +602,49 @@ void GW2_SCT::Options::paintGeneral() {
 	}
 	if (ImGui::IsItemHovered())
 		ImGui::SetTooltip(langString(LanguageCategory::Option_UI, LanguageKey::General_Out_Only_For_Target_Toolip));
+
+	if (ImGui::Checkbox(langString(LanguageCategory::Option_UI, LanguageKey::General_Coalesce_Events), &currentProfile->coalesceIngestedEvents)) {
+		requestSave();
+	}
+	if (ImGui::IsItemHovered())
+		ImGui::SetTooltip(langString(LanguageCategory::Option_UI, LanguageKey::General_Coalesce_Events_Toolip));
+
+	if (ImGui::BeginCombo(
+		ImGui::BuildVisibleLabel(langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_Mode), "overload-mode-combo").c_str(),
+		overloadModeNames.at(currentProfile->overloadMode).c_str())
+		) {
+		int i = 0;
+		for (auto& overloadModeAndName : overloadModeNames) {
+			if (ImGui::Selectable(ImGui::BuildLabel(overloadModeAndName.second, "overload-mode-selectable", i).c_str())) {
+				if (currentProfile->overloadMode != overloadModeAndName.first) {
+					currentProfile->overloadMode = overloadModeAndName.first;
+					requestSave();
+				}
+			}
+			i++;
+		}
+		ImGui::EndCombo();
+	}
+	if (ImGui::IsItemHovered())
+		ImGui::SetTooltip(langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_Mode_Toolip));
+
+	if (currentProfile->overloadMode != OverloadMode::OFF) {
+		if (ImGui::ClampingDragInt(langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_Queue_Depth), &currentProfile->overloadQueueDepth, 1, 1, 500)) {
+			requestSave();
+		}
+		if (ImGui::ClampingDragFloat(langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_Frame_Budget), &currentProfile->overloadFrameBudgetMs, 0.1f, 0.f, 50.f, "%.1f")) {
+			requestSave();
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip(langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_Frame_Budget_Toolip));
+	}
+	OverloadCounters overloadCounters = OverloadStats::get();
+	ImGui::TextDisabled(langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_Counters),
+		(unsigned long long)overloadCounters.droppedMessages, (unsigned long long)overloadCounters.collapsedMessages,
+		(unsigned long long)overloadCounters.deferredFrames, (unsigned long long)overloadCounters.ingestDropped);
+	DrawCounters drawCounters = QuadBatch::lastFrame();
+	ImGui::TextDisabled(langString(LanguageCategory::Option_UI, LanguageKey::General_Draw_Counters),
+		drawCounters.quads, drawCounters.textureSwitches, drawCounters.drawCommands);
 }
 
 void GW2_SCT::Options::paintScrollAreas(const std::vector<std::shared_ptr<ScrollArea>>& scrollAreas) {
@@ -722,10 +853,19 @@ void GW2_SCT::Options::paintScrollAreas(const std::vector<std::shared_ptr<Scroll
                 if (ImGui::Checkbox(langString(GW2_SCT::LanguageCategory::Scroll_Area_Option_UI, GW2_SCT::LanguageKey::Disable_Message_Combining), &scrollAreaOptions->disableCombining)) {
                     requestSave();
                 }
+                if (!scrollAreaOptions->disableCombining) {
+                    if (ImGui::ClampingDragInt(langString(GW2_SCT::LanguageCategory::Scroll_Area_Option_UI, GW2_SCT::LanguageKey::Combine_Window), &scrollAreaOptions->combineWindowMs, 10, 0, 5000)) {
+                        requestSave();
+                    }
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip("%s", langString(GW2_SCT::LanguageCategory::Scroll_Area_Option_UI, GW2_SCT::LanguageKey::Combine_Window_Tooltip));
+                    }
+                }
                 if (ImGui::Checkbox(langString(GW2_SCT::LanguageCategory::Scroll_Area_Option_UI, GW2_SCT::LanguageKey::Show_Combined_Hit_Count), &scrollAreaOptions->showCombinedHitCount)) {
                     requestSave();
                 }
                 if (ImGui::Checkbox(langString(GW2_SCT::LanguageCategory::Scroll_Area_Option_UI, GW2_SCT::LanguageKey::Merge_Crit_With_Hit), &scrollAreaOptions->mergeCritWithHit)) {
+                    ScrollArea::invalidateRouting();
                     requestSave();
                 }
                 if (ImGui::IsItemHovered()) {
@@ -873,6 +1013,9 @@ void GW2_SCT::Options::paintScrollAreas(const std::vector<std::shared_ptr<Scroll
                     requestSave();
                 }
                 else {
+                    if (receiverReturnFlags & ReceiverCollapsible_Rerouted) {
+                        ScrollArea::invalidateRouting();
+                    }
                     if (receiverReturnFlags != 0) {
                         requestSave();
                     }
@@ -1,5 +1,6 @@
 #include "OptionsStructures.h"
 #include "Message.h"
+#include "Options.h"
 #include <memory>
 #include <map>
 #include <utility>
@@ -47,6 +48,43 @@ namespace GW2_SCT {
         }
     }
 
+    int overloadModeToInt(OverloadMode mode) {
+        return static_cast<int>(mode);
+    }
+    OverloadMode intToOverloadMode(int i) {
+        switch (i) {
+        case 1: return OverloadMode::DROP_LOWEST_VALUE;
+        case 2: return OverloadMode::DROP_OLDEST;
+        case 3: return OverloadMode::COLLAPSE;
+        case 0:
+        default: return OverloadMode::OFF;
+        }
+    }
+
+    int numberFormatStyleToInt(NumberFormatStyle style) {
+        return static_cast<int>(style);
+    }
+    NumberFormatStyle intToNumberFormatStyle(int i) {
+        switch (i) {
+        case 1: return NumberFormatStyle::COMMA_GROUPED;
+        case 2: return NumberFormatStyle::DOT_GROUPED;
+        case 3: return NumberFormatStyle::SPACE_GROUPED;
+        case 4: return NumberFormatStyle::DECIMAL_COMMA;
+        case 0:
+        default: return NumberFormatStyle::PLAIN;
+        }
+    }
+    NumberFormat numberFormatOf(NumberFormatStyle style) {
+        switch (style) {
+        case NumberFormatStyle::COMMA_GROUPED: return { '.', ',' };
+        case NumberFormatStyle::DOT_GROUPED: return { ',', '.' };
+        case NumberFormatStyle::SPACE_GROUPED: return { ',', ' ' };
+        case NumberFormatStyle::DECIMAL_COMMA: return { ',', '\0' };
+        case NumberFormatStyle::PLAIN:
+        default: return { '.', '\0' };
+        }
+    }
+
     int scrollDirectionToInt(ScrollDirection type) {
         return static_cast<int>(type);
     }
@@ -204,6 +242,11 @@ namespace GW2_SCT {
         j["defaultCritFontSize"] = p.defaultCritFontSize;
         j["selfMessageOnlyIncoming"] = p.selfMessageOnlyIncoming;
         j["outgoingOnlyToTarget"] = p.outgoingOnlyToTarget;
+        j["coalesceIngestedEvents"] = p.coalesceIngestedEvents;
+        j["overloadMode"] = overloadModeToInt(p.overloadMode);
+        j["overloadQueueDepth"] = p.overloadQueueDepth;
+        j["overloadFrameBudgetMs"] = p.overloadFrameBudgetMs;
+        j["numberFormatStyle"] = numberFormatStyleToInt(p.numberFormatStyle);
         j["professionColorGuardian"] = p.professionColorGuardian;
         j["professionColorWarrior"] = p.professionColorWarrior;
         j["professionColorEngineer"] = p.professionColorEngineer;
@@ -239,6 +282,11 @@ namespace GW2_SCT {
         if (j.contains("defaultCritFontSize")) j.at("defaultCritFontSize").get_to(p.defaultCritFontSize);
         if (j.contains("selfMessageOnlyIncoming")) j.at("selfMessageOnlyIncoming").get_to(p.selfMessageOnlyIncoming);
         if (j.contains("outgoingOnlyToTarget")) j.at("outgoingOnlyToTarget").get_to(p.outgoingOnlyToTarget);
+        if (j.contains("coalesceIngestedEvents")) j.at("coalesceIngestedEvents").get_to(p.coalesceIngestedEvents);
+        if (j.contains("overloadMode")) { int v{}; j.at("overloadMode").get_to(v); p.overloadMode = intToOverloadMode(v); }
+        if (j.contains("overloadQueueDepth")) j.at("overloadQueueDepth").get_to(p.overloadQueueDepth);
+        if (j.contains("overloadFrameBudgetMs")) j.at("overloadFrameBudgetMs").get_to(p.overloadFrameBudgetMs);
+        if (j.contains("numberFormatStyle")) { int v{}; j.at("numberFormatStyle").get_to(v); p.numberFormatStyle = intToNumberFormatStyle(v); }
         if (j.contains("professionColorGuardian")) j.at("professionColorGuardian").get_to(p.professionColorGuardian);
         if (j.contains("professionColorWarrior")) j.at("professionColorWarrior").get_to(p.professionColorWarrior);
         if (j.contains("professionColorEngineer")) j.at("professionColorEngineer").get_to(p.professionColorEngineer);
@@ -295,6 +343,7 @@ namespace GW2_SCT {
         j["abbreviateSkillNames"] = p.abbreviateSkillNames;
         j["shortenNumbersPrecision"] = p.shortenNumbersPrecision;
         j["disableCombining"] = p.disableCombining;
+        j["combineWindowMs"] = p.combineWindowMs;
         j["showCombinedHitCount"] = p.showCombinedHitCount;
         j["mergeCritWithHit"] = p.mergeCritWithHit;
         j["customScrollSpeed"] = p.customScrollSpeed;
@@ -323,6 +372,7 @@ namespace GW2_SCT {
         if (j.contains("abbreviateSkillNames")) j.at("abbreviateSkillNames").get_to(p.abbreviateSkillNames);
         if (j.contains("shortenNumbersPrecision")) j.at("shortenNumbersPrecision").get_to(p.shortenNumbersPrecision);
         if (j.contains("disableCombining")) j.at("disableCombining").get_to(p.disableCombining);
+        if (j.contains("combineWindowMs")) j.at("combineWindowMs").get_to(p.combineWindowMs);
         if (j.contains("showCombinedHitCount")) j.at("showCombinedHitCount").get_to(p.showCombinedHitCount);
         if (j.contains("mergeCritWithHit")) j.at("mergeCritWithHit").get_to(p.mergeCritWithHit);
         if (j.contains("customScrollSpeed")) j.at("customScrollSpeed").get_to(p.customScrollSpeed);
@@ -380,26 +430,43 @@ namespace GW2_SCT {
         if (j.contains("thresholdRespectFilters")) j.at("thresholdRespectFilters").get_to(p.thresholdRespectFilters);
     }
 
-    bool message_receiver_options_struct::isThresholdExceeded(std::shared_ptr<EventMessage> message, uint32_t skillId, const std::string& skillName, const SkillFilterManager& filterManager) const {
-        auto globalOptions = Options::get();
+    bool message_receiver_options_struct::isSkillFiltered(uint32_t skillId, InternedString skillName, const SkillFilterManager& filterManager) const {
+        if (!filtersEnabled || assignedFilterSets.empty()) {
+            return false;
+        }
+        if (transient_compiledFilterGeneration != filterManager.getGeneration()) {
+            transient_compiledFilter.compile(assignedFilterSets, filterManager);
+            transient_filterVerdicts.clear();
+            transient_compiledFilterGeneration = filterManager.getGeneration();
+        }
+        bool filtered;
+        if (!transient_filterVerdicts.find(skillId, skillName, filtered)) {
+            filtered = transient_compiledFilter.isFiltered(skillId, StringInterner::view(skillName));
+            transient_filterVerdicts.store(skillId, skillName, filtered);
+        }
+        return filtered;
+    }
+
+    bool message_receiver_options_struct::isThresholdExceeded(const EventMessage& message, uint32_t skillId, InternedString skillName, const SkillFilterManager& filterManager) const {
+        const HotOptions& globalOptions = Options::hot();
         
-        bool thresholdsActive = thresholdsEnabled || (globalOptions->globalThresholdsEnabled && !thresholdsEnabled);
-        if (!thresholdsActive && !globalOptions->globalThresholdsEnabled) {
+        bool thresholdsActive = thresholdsEnabled || (globalOptions.globalThresholdsEnabled && !thresholdsEnabled);
+        if (!thresholdsActive && !globalOptions.globalThresholdsEnabled) {
             return false;
         }
 
-        bool respectFilters = thresholdsEnabled ? thresholdRespectFilters : globalOptions->globalThresholdRespectFilters;
+        bool respectFilters = thresholdsEnabled ? thresholdRespectFilters : globalOptions.globalThresholdRespectFilters;
         
         if (respectFilters && filtersEnabled && !assignedFilterSets.empty() && !isSkillFiltered(skillId, skillName, filterManager)) {
             return false;
         }
 
-        ThresholdCategory category = getMessageThresholdCategory(message->getType());
-        int32_t totalValue = message->getCombinedValue();
+        ThresholdCategory category = getMessageThresholdCategory(message.getType());
+        int32_t totalValue = message.getCombinedValue();
 
-        int activeDamageThreshold = thresholdsEnabled ? damageThreshold : globalOptions->globalDamageThreshold;
-        int activeHealThreshold = thresholdsEnabled ? healThreshold : globalOptions->globalHealThreshold;
-        int activeAbsorbThreshold = thresholdsEnabled ? absorbThreshold : globalOptions->globalAbsorbThreshold;
+        int activeDamageThreshold = thresholdsEnabled ? damageThreshold : globalOptions.globalDamageThreshold;
+        int activeHealThreshold = thresholdsEnabled ? healThreshold : globalOptions.globalHealThreshold;
+        int activeAbsorbThreshold = thresholdsEnabled ? absorbThreshold : globalOptions.globalAbsorbThreshold;
 
         switch (category) {
             case ThresholdCategory::DAMAGE:
@@ -414,6 +481,27 @@ namespace GW2_SCT {
         }
     }
 
+    std::shared_ptr<const CompiledTemplate> message_receiver_options_struct::getCompiledTemplate(MessageCategory messageCategory, MessageType messageType) {
+        if (!transient_compiledTemplate
+            || transient_compiledTemplateGeneration != outputTemplate.getGeneration()
+            || transient_compiledColorGeneration != color.getGeneration()
+            || transient_compiledCategory != messageCategory
+            || transient_compiledType != messageType) {
+            transient_compiledTemplate = CompiledTemplate::compile(outputTemplate, color, messageCategory, messageType);
+            if (transient_compiledTemplate->error != TemplateError::NONE) {
+                TemplateParseResult parsed;
+                parsed.error = transient_compiledTemplate->error;
+                parsed.errorPosition = transient_compiledTemplate->errorPosition;
+                LOG("Output template \"", std::string(outputTemplate), "\" is invalid: ", TemplateParser::describeError(parsed));
+            }
+            transient_compiledTemplateGeneration = outputTemplate.getGeneration();
+            transient_compiledColorGeneration = color.getGeneration();
+            transient_compiledCategory = messageCategory;
+            transient_compiledType = messageType;
+        }
+        return transient_compiledTemplate;
+    }
+
     message_receiver_options_struct::ThresholdCategory message_receiver_options_struct::getMessageThresholdCategory(MessageType type) const {
         switch (type) {
             case MessageType::PHYSICAL:
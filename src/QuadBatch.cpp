@@ -0,0 +1,79 @@
+#include "QuadBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// Keeps every reservation well inside the 16 bit index range of a draw command
+	constexpr size_t MAX_QUADS_PER_RESERVE = 8192;
+}
+
+GW2_SCT::QuadBatch::Group& GW2_SCT::QuadBatch::groupFor(QuadLayer layer, Texture* texture) {
+	// Glyphs of one text come in runs of the same atlas page, so the last group almost always matches
+	if (lastGroup < groups.size() && groups[lastGroup].layer == layer && groups[lastGroup].texture == texture) {
+		return groups[lastGroup];
+	}
+	for (size_t i = 0; i < groups.size(); i++) {
+		if (groups[i].layer == layer && groups[i].texture == texture) {
+			lastGroup = i;
+			return groups[i];
+		}
+	}
+	lastGroup = groups.size();
+	Group& group = groups.emplace_back();
+	group.layer = layer;
+	group.texture = texture;
+	return group;
+}
+
+void GW2_SCT::QuadBatch::add(QuadLayer layer, Texture* texture, ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color) {
+	if (texture == nullptr || (color & IM_COL32_A_MASK) == 0) return;
+	if (texture != lastAddedTexture) {
+		frameCounters.textureSwitches++;
+		lastAddedTexture = texture;
+	}
+	frameCounters.quads++;
+	Group& group = groupFor(layer, texture);
+	group.usedThisFrame = true;
+	group.quads.push_back({ pos, ImVec2(pos.x + size.x, pos.y + size.y), uvStart, uvEnd, color });
+}
+
+void GW2_SCT::QuadBatch::addLayout(QuadLayer layer, const std::vector<FontType::GlyphQuad>& quads, ImVec2 pos, ImU32 color) {
+	if ((color & IM_COL32_A_MASK) == 0) return;
+	for (const FontType::GlyphQuad& quad : quads) {
+		add(layer, quad.texture, ImVec2(ceil(pos.x + quad.offset.x), ceil(pos.y + quad.offset.y)), quad.size, quad.uvStart, quad.uvEnd, color);
+	}
+}
+
+void GW2_SCT::QuadBatch::flush() {
+	ImDrawList* drawList = ImGui::GetForegroundDrawList();
+	for (QuadLayer layer : { QuadLayer::SHADOW, QuadLayer::TEXT, QuadLayer::ICON }) {
+		for (Group& group : groups) {
+			if (group.layer != layer || group.quads.empty()) continue;
+			ImTextureID textureId = group.texture->prepareDraw();
+			if (textureId != nullptr) {
+				drawList->PushTextureID(textureId);
+				for (size_t start = 0; start < group.quads.size(); start += MAX_QUADS_PER_RESERVE) {
+					size_t count = std::min(group.quads.size() - start, MAX_QUADS_PER_RESERVE);
+					drawList->PrimReserve((int)count * 6, (int)count * 4);
+					for (size_t i = start; i < start + count; i++) {
+						const Quad& quad = group.quads[i];
+						drawList->PrimRectUV(quad.min, quad.max, quad.uvStart, quad.uvEnd, quad.color);
+					}
+				}
+				drawList->PopTextureID();
+				frameCounters.drawCommands++;
+			}
+			group.quads.clear();
+		}
+	}
+}
+
+void GW2_SCT::QuadBatch::endFrame() {
+	flush();
+	groups.erase(std::remove_if(groups.begin(), groups.end(), [](const Group& group) { return !group.usedThisFrame; }), groups.end());
+	for (Group& group : groups) group.usedThisFrame = false;
+	lastGroup = 0;
+	lastAddedTexture = nullptr;
+	lastFrameCounters = frameCounters;
+	frameCounters = {};
+}
@@ -14,8 +14,13 @@
 #include "Mumblelink.h"
 #include "Updater.h"
 #include "autoversion.h"
+#include "MpscRingBuffer.h"
+#include "EvtcReplay.h"
+#include "EventCoalescer.h"
+#include "OverloadStats.h"
+#include "QuadBatch.h"
+#include <array>
 #include <chrono>
-#include <queue>
 #include <mutex>
 #include <codecvt>
 #include <locale>
@@ -23,13 +28,28 @@
 #if _DEBUG
 long uiFrames = 0;
 float uiTime = 0;
+float uiDrainTime = 0;
+float uiPaintTime = 0;
 #endif
 
 float windowWidth;
 float windowHeight;
 
-static std::queue<std::shared_ptr<GW2_SCT::EventMessage>> s_incomingMessageQueue;
-static std::mutex s_queueMutex;
+// Filled by the arcdps combat thread (and the example message thread), drained once per frame in UIUpdate.
+// Under a flood the oldest pending events are evicted, newer hits are more relevant on screen.
+static GW2_SCT::MpscRingBuffer<GW2_SCT::EventRecord, 8192> s_incomingMessageQueue(GW2_SCT::RingOverflowPolicy::DROP_OLDEST);
+static uint64_t s_lastLoggedIngestDrops = 0;
+static std::chrono::steady_clock::time_point s_lastIngestDropLog;
+// Optional stage behind the queue that folds same-skill hits drained in one frame into one record
+static GW2_SCT::EventCoalescer s_ingestCoalescer(2048);
+
+static const char* unknownEventName(GW2_SCT::UnknownName name) {
+	switch (name) {
+	case GW2_SCT::UnknownName::SKILL: return langStringG(GW2_SCT::LanguageKey::Unknown_Skill_Name);
+	case GW2_SCT::UnknownName::SOURCE: return langStringG(GW2_SCT::LanguageKey::Unknown_Skill_Source);
+	default: return langStringG(GW2_SCT::LanguageKey::Unknown_Skill_Target);
+	}
+}
 
 
 GW2_SCT::SCTMain::SCTMain() : arc_exports{} {}
@@ -71,10 +91,13 @@ arcdps_exports* GW2_SCT::SCTMain::Init(char* arcvers, void* mod_wnd, void* mod_c
 	LOG("Started font manager");
 	Options::load();
 	LOG("Loaded options");
+	// Room for the skill and agent names of a long session, so the combat callback only copies text when interning
+	StringInterner::reserve(8192, 256 * 1024);
 
 	Updater::Init();
 	LOG("Updater initialized");
 
+	Options::publishHotOptions();
 	resetScrollAreas(Options::get());
 	LOG("Created ", scrollAreas.size(), " scroll areas");
 
@@ -112,24 +135,17 @@ arcdps_exports* GW2_SCT::SCTMain::Init(char* arcvers, void* mod_wnd, void* mod_c
 		in.close();
 		try {
 			std::map<std::string, std::string> remapJsonValues = nlohmann::json::parse(text);
+			std::map<uint32_t, uint32_t> remaps;
 			for (const auto& entry : remapJsonValues) {
-				uint32_t from = stoi(std::string(entry.first));
-				uint32_t to = stoi(std::string(entry.second));
-				while (skillRemaps.find(to) != skillRemaps.end()) {
-					if (from == to) break;
-					to = skillRemaps[to];
+				try {
+					remaps[std::stoul(entry.first)] = std::stoul(entry.second);
 				}
-				if (from == to) break;
-				LOG("Remapping id ", from, " to id ", to);
-				for (auto currentRemap : skillRemaps) {
-					if (currentRemap.second == from) {
-						skillRemaps[currentRemap.first] = to;
-						LOG("Touched remap from id ", currentRemap.first, " to id ", to);
-					}
+				catch (std::exception&) {
+					LOG("Ignoring invalid remap entry \"", entry.first, "\": \"", entry.second, "\"");
 				}
-				skillRemaps[from] = to;
 			}
-			LOG("Loaded remap.json successfully: ", skillRemaps.size(), " remapped skills")
+			SkillRemapDiagnostics diagnostics = skillRemaps.compile(remaps);
+			LOG("Loaded remap.json successfully: ", diagnostics.entries, " remapped skills, ", diagnostics.chains, " chains resolved (longest ", diagnostics.longestChain, " hops), ", diagnostics.cycles, " dropped in cycles, ", diagnostics.selfMaps, " self-maps ignored");
 		}
 		catch (std::exception& e) {
 			LOG("Error parsing remap.json");
@@ -140,6 +156,7 @@ arcdps_exports* GW2_SCT::SCTMain::Init(char* arcvers, void* mod_wnd, void* mod_c
 	}
 
 	ExampleMessageOptions::setMain(this);
+	EvtcReplay::setMain(this);
 
 	/* for arcdps */
 	memset(&arc_exports, 0, sizeof(arcdps_exports));
@@ -157,6 +174,9 @@ arcdps_exports* GW2_SCT::SCTMain::Init(char* arcvers, void* mod_wnd, void* mod_c
 }
 
 uintptr_t GW2_SCT::SCTMain::Release() {
+	EvtcReplay::stop();
+	StringInternerStats internerStats = StringInterner::getStats();
+	LOG("Interned ", internerStats.strings, " names using ", internerStats.stringBytes, " bytes of text and ~", internerStats.tableBytes, " bytes of tables, ", internerStats.hits, " of ", internerStats.lookups, " lookups hit (", internerStats.keyedHits, " by id)");
 	SkillIconManager::cleanup();
 	Updater::Shutdown();
 	MumbleLink::i().shutdown();
@@ -180,12 +200,12 @@ uintptr_t GW2_SCT::SCTMain::CombatEventArea(cbtevent* ev, ag* src, ag* dst, char
 		if (revision == 1) {
 			cbtevent1* ev1 = reinterpret_cast<cbtevent1*>(ev);
 			if (src && src->self) {
-				selfInstID = ev1->src_instid;
+				ingestState.selfInstId = ev1->src_instid;
 			}
 		}
 		else {
 			if (src && src->self) {
-				selfInstID = ev->src_instid;
+				ingestState.selfInstId = ev->src_instid;
 			}
 		}
 	}
@@ -198,126 +218,10 @@ uintptr_t GW2_SCT::SCTMain::CombatEventLocal(cbtevent* ev, ag* src, ag* dst, cha
 	if (ev) {
 		if (revision == 1) {
 			cbtevent1* ev1 = reinterpret_cast<cbtevent1*>(ev);
-
-			/* default names */
-			if (!src->name || !strlen(src->name)) src->name = _strdup(langStringG(LanguageKey::Unknown_Skill_Source));
-			if (!dst->name || !strlen(dst->name)) dst->name = _strdup(langStringG(LanguageKey::Unknown_Skill_Target));
-			if (!skillname || !strlen(skillname)) skillname = _strdup(langStringG(LanguageKey::Unknown_Skill_Name));
-
-			if (src->self) {
-				selfInstID = ev1->src_instid;
-			}
-			if (dst->self) {
-				selfInstID = ev1->dst_instid;
-			}
-
-			/* statechange */
-			if (ev1->is_statechange) {
-				return 0;
-			}
-
-			/* activation */
-			else if (ev1->is_activation) {
-				return 0;
-			}
-
-			/* buff remove */
-			else if (ev1->is_buffremove) {
-				return 0;
-			}
-
-			else {
-				std::vector<MessageType> types;
-
-				if (ev1->buff) {
-					// Buff-based effects (DoT, HoT, etc.)
-					if (ev1->buff_dmg > 0) {
-						if (ev1->overstack_value != 0) {
-							ev1->buff_dmg -= ev1->overstack_value;
-							types.push_back(MessageType::SHIELD_RECEIVE);
-						}
-						if (ev1->buff_dmg > 0) {
-							types.push_back(MessageType::HOT);
-						}
-					}
-					else if (ev1->buff_dmg < 0) {
-						if (ev1->overstack_value > 0) {
-							ev1->buff_dmg += ev1->overstack_value;
-							types.push_back(MessageType::SHIELD_REMOVE);
-						}
-						if (ev1->buff_dmg < 0) {
-							switch (ev1->skillid) {
-							case 736: types.push_back(MessageType::BLEEDING); break;
-							case 737: types.push_back(MessageType::BURNING); break;
-							case 723: types.push_back(MessageType::POISON); break;
-							case 861: types.push_back(MessageType::CONFUSION); break;
-							case 19426: types.push_back(MessageType::TORMENT); break;
-							default: types.push_back(MessageType::DOT); break;
-							}
-						}
-					}
-				}
-				else {
-					// Non-buff effects (direct damage, healing, barriers)
-					if (ev1->value > 0) {
-						if (ev1->overstack_value != 0) {
-							types.push_back(MessageType::SHIELD_RECEIVE);
-						}
-						else {
-							types.push_back(MessageType::HEAL);
-						}
-					}
-					else {
-						if (ev1->overstack_value > 0) {
-							ev1->value += ev1->overstack_value;
-							types.push_back(MessageType::SHIELD_REMOVE);
-						}
-						if (ev1->overstack_value <= 0 || ev1->value < 0) {
-							switch (ev1->result) {
-							case CBTR_GLANCE:
-							case CBTR_INTERRUPT:
-							case CBTR_NORMAL: types.push_back(MessageType::PHYSICAL); break;
-							case CBTR_CRIT: types.push_back(MessageType::CRIT); break;
-							case CBTR_BLOCK: types.push_back(MessageType::BLOCK);  break;
-							case CBTR_EVADE: types.push_back(MessageType::EVADE); break;
-							case CBTR_ABSORB: types.push_back(MessageType::INVULNERABLE); break;
-							case CBTR_BLIND: types.push_back(MessageType::MISS); break;
-							default:
-								break;
-							}
-						}
-					}
-				}
-
-				if (types.size() > 0) {
-					ev1->skillid = remapSkillID(ev1->skillid);
-				}
-
-				for (auto type : types) {
-					// Player outgoing damage/effects
-					if (src->self == 1 && (!Options::get()->outgoingOnlyToTarget || dst->id == targetAgentId)) {
-						if (!Options::get()->selfMessageOnlyIncoming || dst->self != 1) {
-							std::shared_ptr<GW2_SCT::EventMessage> m = std::make_shared<GW2_SCT::EventMessage>(MessageCategory::PLAYER_OUT, type, ev1, src, dst, skillname);
-							sendMessageToEmission(m);
-						}
-					}
-					// Pet outgoing damage/effects
-					else if (ev1->src_master_instid == selfInstID && (!Options::get()->outgoingOnlyToTarget || dst->id == targetAgentId)) {
-						std::shared_ptr<GW2_SCT::EventMessage> m = std::make_shared<GW2_SCT::EventMessage>(MessageCategory::PET_OUT, type, ev1, src, dst, skillname);
-						sendMessageToEmission(m);
-					}
-
-					// Player incoming damage/effects
-					if (dst->self == 1) {
-						std::shared_ptr<GW2_SCT::EventMessage> m = std::make_shared<GW2_SCT::EventMessage>(MessageCategory::PLAYER_IN, type, ev1, src, dst, skillname);
-						sendMessageToEmission(m);
-					}
-					// Pet incoming damage/effects
-					else if (ev1->dst_master_instid == selfInstID) {
-						std::shared_ptr<GW2_SCT::EventMessage> m = std::make_shared<GW2_SCT::EventMessage>(MessageCategory::PET_IN, type, ev1, src, dst, skillname);
-						sendMessageToEmission(m);
-					}
-				}
+			EventRecord record;
+			if (buildEventRecord(ingestState, Options::combatHot(), *ev1, *src, *dst, skillname, unknownEventName, record)) {
+				record.skillId = remapSkillID(record.skillId);
+				sendMessageToEmission(record);
 			}
 		}
 		else {
@@ -328,7 +232,7 @@ uintptr_t GW2_SCT::SCTMain::CombatEventLocal(cbtevent* ev, ag* src, ag* dst, cha
 	else {
 		// Target agent handling when ev is null
 		if (src != nullptr) {
-			targetAgentId = src->id;
+			ingestState.targetAgentId = src->id;
 		}
 	}
 	return 0;
@@ -357,21 +261,63 @@ uintptr_t GW2_SCT::SCTMain::UIUpdate() {
 	GW2_SCT::Texture::BeginPresentCycle();
 
 	{
-		std::queue<std::shared_ptr<EventMessage>> localQueue;
-		{
-			std::lock_guard<std::mutex> lock(s_queueMutex);
-			std::swap(localQueue, s_incomingMessageQueue);
+	#if _DEBUG
+		auto drain_start = std::chrono::high_resolution_clock::now();
+	#endif
+		// Under an overload mode the routing work per frame is bounded, whatever is left waits for the next frame
+		const HotOptions& hotOptions = Options::hot();
+		const bool budgeted = hotOptions.overloadMode != OverloadMode::OFF && hotOptions.overloadFrameBudgetMs > 0.f;
+		const auto drainDeadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(hotOptions.overloadFrameBudgetMs));
+		bool overBudget = false;
+		size_t routed = 0;
+		auto routeWithinBudget = [&](const EventRecord& record) {
+			routeEvent(record);
+			ExampleMessageOptions::receiveMessage(record);
+			if (budgeted && (++routed % 16) == 0 && std::chrono::steady_clock::now() >= drainDeadline) {
+				overBudget = true;
+			}
+		};
+
+		// Only drain what was queued when the frame started, producers may keep pushing meanwhile
+		size_t pending = s_incomingMessageQueue.size();
+		if (hotOptions.coalesceIngestedEvents) {
+			while (pending-- > 0 && !s_ingestCoalescer.full()) {
+				std::optional<EventRecord> record = s_incomingMessageQueue.pop();
+				if (!record) break;
+				s_ingestCoalescer.add(*record);
+			}
+		}
+		// Folded records are older than anything still queued, including those left over from a frame over budget
+		const std::vector<EventRecord>& coalescedRecords = s_ingestCoalescer.pendingRecords();
+		size_t routedCoalesced = 0;
+		while (routedCoalesced < coalescedRecords.size() && !overBudget) {
+			routeWithinBudget(coalescedRecords[routedCoalesced++]);
+		}
+		s_ingestCoalescer.consume(routedCoalesced);
+		if (!hotOptions.coalesceIngestedEvents) {
+			while (pending-- > 0 && !overBudget) {
+				std::optional<EventRecord> record = s_incomingMessageQueue.pop();
+				if (!record) break;
+				routeWithinBudget(*record);
+			}
+		}
+		if (overBudget) {
+			OverloadStats::addDeferredFrame();
 		}
 
-		while (!localQueue.empty()) {
-			std::shared_ptr<EventMessage> msg = localQueue.front();
-			localQueue.pop();
-
-			for (auto scrollArea : scrollAreas) {
-				scrollArea->receiveMessage(msg);
+		RingBufferStats ingestStats = s_incomingMessageQueue.getStats();
+		OverloadStats::setIngestDropped(ingestStats.dropped);
+		if (ingestStats.dropped != s_lastLoggedIngestDrops) {
+			auto now = std::chrono::steady_clock::now();
+			if (now - s_lastIngestDropLog >= std::chrono::seconds(10)) {
+				LOG("WARNING: Incoming event queue overflowed, dropped ", ingestStats.dropped - s_lastLoggedIngestDrops, " events (high-water mark ", ingestStats.highWaterMark, "/", ingestStats.capacity, ")");
+				s_lastLoggedIngestDrops = ingestStats.dropped;
+				s_lastIngestDropLog = now;
 			}
-			ExampleMessageOptions::receiveMessage(msg);
 		}
+	#if _DEBUG
+		uiDrainTime += (std::chrono::high_resolution_clock::now() - drain_start) / std::chrono::microseconds(1);
+	#endif
 	}
 
 	GW2_SCT::SkillIcon::ProcessPendingIconTextures();
@@ -379,16 +325,25 @@ uintptr_t GW2_SCT::SCTMain::UIUpdate() {
 	FontType::ensureAtlasCreation();
 	
 	Profiles::processPendingSwitch();
+	Options::publishHotOptions();
 
 	Options::paint(scrollAreas);
 	Options::paintScrollAreaOverlay(scrollAreas);
 	ExampleMessageOptions::paint();
 	Updater::DrawPopup();
-	if (Options::get()->sctEnabled) {
+#if _DEBUG
+	auto paint_start = std::chrono::high_resolution_clock::now();
+#endif
+	if (Options::hot().sctEnabled) {
 		for (std::shared_ptr<ScrollArea> scrollArea : scrollAreas) {
 			scrollArea->paint();
+			QuadBatch::flush();
 		}
 	}
+	QuadBatch::endFrame();
+#if _DEBUG
+	uiPaintTime += (std::chrono::high_resolution_clock::now() - paint_start) / std::chrono::microseconds(1);
+#endif
 
 #if _DEBUG
 	auto time = std::chrono::high_resolution_clock::now() - start_time;
@@ -396,8 +351,18 @@ uintptr_t GW2_SCT::SCTMain::UIUpdate() {
 	uiTime += time / std::chrono::microseconds(1);
 	if (uiFrames >= 1000) {
 		LOG("time per ui update: ", uiTime / uiFrames, "ns");
+		LOG("  of which draining/routing events: ", uiDrainTime / uiFrames, "us, painting scroll areas: ", uiPaintTime / uiFrames, "us");
+		RingBufferStats ingestStats = s_incomingMessageQueue.getStats();
+		LOG("incoming event queue: ", ingestStats.pushed, " pushed, ", ingestStats.dropped, " dropped, high-water mark ", ingestStats.highWaterMark, "/", ingestStats.capacity);
+		s_incomingMessageQueue.resetHighWaterMark();
+		EventCoalescerStats coalescerStats = s_ingestCoalescer.getStats();
+		LOG("coalesced events: ", coalescerStats.folded, " of ", coalescerStats.added, " folded");
+		StringInternerStats internerStats = StringInterner::getStats();
+		LOG("interned names: ", internerStats.strings, " (", internerStats.stringBytes + internerStats.tableBytes, " bytes), ", internerStats.hits, "/", internerStats.lookups, " hits, ", internerStats.keyedHits, " by id");
 		uiFrames = 0;
 		uiTime = 0;
+		uiDrainTime = 0;
+		uiPaintTime = 0;
 	}
 #endif
 	return 0;
@@ -419,25 +384,57 @@ uintptr_t GW2_SCT::SCTMain::UIOptions() {
 	return 0;
 }
 
-void GW2_SCT::SCTMain::sendMessageToEmission(std::shared_ptr<EventMessage> m) {
-	if (m->hasToBeFiltered()) return;
+void GW2_SCT::SCTMain::sendMessageToEmission(const EventRecord& record) {
+	s_incomingMessageQueue.push(record);
+}
+
+void GW2_SCT::SCTMain::ensureScrollAreaRoutes() {
+	uint64_t generation = ScrollArea::getRoutingGeneration();
+	if (scrollAreaRoutesGeneration == generation) return;
 
-	std::lock_guard<std::mutex> lock(s_queueMutex);
-	s_incomingMessageQueue.push(m);
+	for (size_t c = 0; c < NUM_CATEGORIES; c++) {
+		for (size_t t = 0; t < NUM_MESSAGE_TYPES; t++) {
+			auto& routes = scrollAreaRoutes[c][t];
+			routes.clear();
+			for (auto& scrollArea : scrollAreas) {
+				if (scrollArea->acceptsMessage((MessageCategory)c, (MessageType)t)) routes.push_back(scrollArea);
+			}
+		}
+	}
+	scrollAreaRoutesGeneration = generation;
 }
 
-inline void clear(std::queue<std::shared_ptr<GW2_SCT::EventMessage>>& q) {
-	std::queue<std::shared_ptr<GW2_SCT::EventMessage>> empty;
-	std::swap(q, empty);
+void GW2_SCT::SCTMain::routeEvent(const EventRecord& record) {
+	ensureScrollAreaRoutes();
+	// One payload per perspective, shared by every type, category and scroll area it is delivered to
+	std::shared_ptr<const MessageData> outgoingPayload, incomingPayload;
+	for (size_t c = 0; c < record.categoryCount; c++) {
+		MessageCategory category = record.categories[c];
+		if ((size_t)category >= NUM_CATEGORIES) continue;
+		for (size_t t = 0; t < record.typeCount; t++) {
+			if ((size_t)record.types[t] >= NUM_MESSAGE_TYPES) continue;
+			const auto& routes = scrollAreaRoutes[(size_t)category][(size_t)record.types[t]];
+			if (routes.empty()) continue;
+			// Built only once a scroll area takes it
+			std::shared_ptr<const MessageData>& shared = isIncomingCategory(category) ? incomingPayload : outgoingPayload;
+			if (!shared) {
+				shared = std::make_shared<const MessageData>(record, category);
+			}
+			RoutedMessage routed{ category, record.types[t], shared, record.timepoint };
+			for (auto& scrollArea : routes) {
+				scrollArea->receiveMessage(routed);
+			}
+		}
+	}
 }
 
 uint32_t GW2_SCT::SCTMain::remapSkillID(uint32_t originalID) {
-	if (skillRemaps.count(originalID) == 0) return originalID;
-	else return skillRemaps[originalID];
+	return skillRemaps.remap(originalID);
 }
 
 void GW2_SCT::SCTMain::resetScrollAreas(std::shared_ptr<profile_options_struct> profile) {
 	scrollAreas.clear();
+	ScrollArea::invalidateRouting();
 	if (!profile) return;
 
 	for (const auto& saOpts : profile->scrollAreaOptions) {
@@ -455,6 +452,8 @@ void GW2_SCT::SCTMain::resetScrollAreas(std::shared_ptr<profile_options_struct>
 			[this](int pos) {
 				if (pos >= 0 && pos < static_cast<int>(scrollAreas.size())) {
 					scrollAreas.erase(std::begin(scrollAreas) + pos);
+					// scrollAreaRoutes still holds the removed scroll area
+					ScrollArea::invalidateRouting();
 				}
 			});
 }
@@ -3,7 +3,11 @@
 #include "imgui.h"
 #include "Common.h"
 #include "Options.h"
+#include "Language.h"
+#include "OverloadStats.h"
+#include "QuadBatch.h"
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <algorithm>
 
@@ -11,92 +15,138 @@ using namespace std::chrono;
 
 GW2_SCT::ScrollArea::ScrollArea(std::shared_ptr<scroll_area_options_struct> options) : options(options) {
 	paintedMessages = std::list<std::pair<MessagePrerender, time_point<steady_clock>>>();
+	// Erase callbacks run before the receiver is gone, so the routes are only rebuilt on the next lookup
+	receiverPushBackCallbackId = options->receivers.addOnPushBackCallback([](const std::shared_ptr<message_receiver_options_struct>&) { invalidateRouting(); });
+	receiverEraseCallbackId = options->receivers.addOnEraseCallback([](int) { invalidateRouting(); });
+	invalidateRouting();
 }
 
-void GW2_SCT::ScrollArea::receiveMessage(std::shared_ptr<EventMessage> m) {
+GW2_SCT::ScrollArea::~ScrollArea() {
+	options->receivers.removeOnPushBackCallback(receiverPushBackCallbackId);
+	options->receivers.removeOnEraseCallback(receiverEraseCallbackId);
+	invalidateRouting();
+}
+
+void GW2_SCT::ScrollArea::ensureReceiverRoutes() {
+	uint64_t generation = getRoutingGeneration();
+	if (receiverRoutesGeneration == generation) return;
+
+	for (auto& routesOfCategory : receiverRoutes) {
+		for (auto& receivers : routesOfCategory) receivers.clear();
+	}
+	for (auto& receiver : options->receivers) {
+		size_t category = (size_t)receiver->category;
+		size_t type = (size_t)receiver->type;
+		if (!receiver->enabled || category >= NUM_CATEGORIES || type >= NUM_MESSAGE_TYPES) continue;
+		if (options->mergeCritWithHit) {
+			// Crits arrive as hits in this scroll area, so crit receivers never get anything
+			if (receiver->type == MessageType::CRIT) continue;
+			if (receiver->type == MessageType::PHYSICAL) receiverRoutes[category][(size_t)MessageType::CRIT].push_back(receiver);
+		}
+		receiverRoutes[category][type].push_back(receiver);
+	}
+	receiverRoutesGeneration = generation;
+}
+
+bool GW2_SCT::ScrollArea::acceptsMessage(MessageCategory category, MessageType type) {
+	if ((size_t)category >= NUM_CATEGORIES || (size_t)type >= NUM_MESSAGE_TYPES) return false;
+	ensureReceiverRoutes();
+	return !receiverRoutes[(size_t)category][(size_t)type].empty();
+}
+
+void GW2_SCT::ScrollArea::receiveMessage(const RoutedMessage& m) {
     if (!options->enabled) return;
+    if ((size_t)m.category >= NUM_CATEGORIES || (size_t)m.type >= NUM_MESSAGE_TYPES) return;
 
-    // Determine effective message and type for this scroll area
-    MessageCategory effCategory = m->getCategory();
-    MessageType effType = m->getType();
-    std::shared_ptr<EventMessage> effMsg = m;
+    // Determine effective type for this scroll area, the payload is shared as is
+    MessageCategory effCategory = m.category;
+    MessageType effType = m.type;
     if (options->mergeCritWithHit && effType == MessageType::CRIT) {
         effType = MessageType::PHYSICAL;
-        // Wrap the message for this scroll area as PHYSICAL
-        effMsg = std::make_shared<EventMessage>(effCategory, effType, m->getCopyOfFirstData());
     }
 
-    auto messageData = effMsg->getCopyOfFirstData();
+    const std::shared_ptr<const MessageData>& messageData = m.payload;
     if (!messageData) return;
 
-    for (auto& receiver : options->receivers) {
-        if (receiver->enabled && effCategory == receiver->category && effType == receiver->type) {
+    // One profile reference for all receivers, instead of one per filter and threshold check
+    std::shared_ptr<profile_options_struct> profile = Options::get();
+    if (!profile) return;
+    const SkillFilterManager& filterManager = profile->filterManager;
 
-            std::string skillName = messageData->skillName ? std::string(messageData->skillName) : "";
-            if (receiver->isSkillFiltered(messageData->skillId, skillName, Options::get()->filterManager)) {
-                continue;
-            }
+    ensureReceiverRoutes();
+    for (auto& receiver : receiverRoutes[(size_t)m.category][(size_t)m.type]) {
+        InternedString skillName = messageData->skillName;
+        if (receiver->isSkillFiltered(messageData->skillId, skillName, filterManager)) {
+            continue;
+        }
 
-			receiver->transient_showCombinedHitCount = options->showCombinedHitCount;
-			receiver->transient_abbreviateSkillNames = options->abbreviateSkillNames;
-			receiver->transient_numberShortPrecision = options->shortenNumbersPrecision;
+		receiver->transient_showCombinedHitCount = options->showCombinedHitCount;
+		receiver->transient_abbreviateSkillNames = options->abbreviateSkillNames;
+		receiver->transient_numberShortPrecision = options->shortenNumbersPrecision;
 
-			std::unique_lock<std::mutex> mlock(messageQueueMutex);
-			
-            if (!options->disableCombining && !messageQueue.empty()) {
-                if (Options::get()->combineAllMessages) {
-                    for (auto it = messageQueue.rbegin(); it != messageQueue.rend(); ++it) {
-                        if (it->options == receiver && it->message->tryToCombineWith(effMsg)) {
-                            if (!receiver->isThresholdExceeded(it->message, messageData->skillId, skillName, Options::get()->filterManager)) {
-                                it->update();
-                            } else {
-                                messageQueue.erase(std::next(it).base());
-                            }
-                            mlock.unlock();
-                            return;
-                        }
+		std::unique_lock<std::mutex> mlock(messageQueueMutex);
+		CombineKey combineKey = combineKeyOf(receiver.get(), effCategory, *messageData);
+		
+        if (!options->disableCombining && !messageQueue.empty()) {
+            if (Options::hot().combineAllMessages) {
+                auto it = messageQueue.findNewest(combineKey);
+                if (it != messageQueue.end() && it->value.message->tryToCombineWith(effCategory, effType, messageData)) {
+                    if (!receiver->isThresholdExceeded(*it->value.message, messageData->skillId, skillName, filterManager)) {
+                        it->value.update();
+                    } else {
+                        messageQueue.erase(it);
                     }
+                    mlock.unlock();
+                    return;
                 }
-                else {
-                    auto backMessage = messageQueue.rbegin();
-                    if (backMessage->options == receiver && backMessage->message->tryToCombineWith(effMsg)) {
-                        if (!receiver->isThresholdExceeded(backMessage->message, messageData->skillId, skillName, Options::get()->filterManager)) {
-                            backMessage->update();
-                        } else {
-                            messageQueue.pop_back();
-                        }
-                        mlock.unlock();
-                        return;
+            }
+            else {
+                MessagePrerender& backMessage = messageQueue.back().value;
+                if (backMessage.options == receiver && backMessage.message->tryToCombineWith(effCategory, effType, messageData)) {
+                    if (!receiver->isThresholdExceeded(*backMessage.message, messageData->skillId, skillName, filterManager)) {
+                        backMessage.update();
+                    } else {
+                        messageQueue.popBack();
                     }
+                    mlock.unlock();
+                    return;
                 }
             }
-            
-            MessagePrerender preMessage = MessagePrerender(effMsg, receiver);
-			
-			if (options->textCurve == TextCurve::ANGLED) {
-				if (options->angledDirection == 0) {
-					preMessage.angledSign = (angledMessageCounter % 2 == 0) ? 1 : -1;
-					angledMessageCounter++;
-				} else {
-					preMessage.angledSign = (options->angledDirection > 0) ? 1 : -1;
-				}
-				
-				float baseDegrees = options->angleDegrees;
-				float jitterRange = options->angleJitterDegrees;
-				float jitter = (std::rand() / (float)RAND_MAX * 2.0f - 1.0f) * jitterRange;
-				float totalDegrees = baseDegrees + jitter;
-				
-				totalDegrees = std::max(0.0f, std::min(45.0f, totalDegrees));
-				
-				preMessage.angledAngleRad = totalDegrees * (M_PI / 180.0f);
+        }
+        if (!options->disableCombining && options->combineWindowMs > 0) {
+            if (combineWithPainted(combineKey, effCategory, effType, messageData)) {
+                mlock.unlock();
+                return;
+            }
+        }
+        
+        MessagePrerender preMessage = MessagePrerender(std::make_shared<EventMessage>(effCategory, effType, messageData, m.timepoint), receiver);
+		
+		if (options->textCurve == TextCurve::ANGLED) {
+			if (options->angledDirection == 0) {
+				preMessage.angledSign = (angledMessageCounter % 2 == 0) ? 1 : -1;
+				angledMessageCounter++;
+			} else {
+				preMessage.angledSign = (options->angledDirection > 0) ? 1 : -1;
 			}
 			
-			if (preMessage.options != nullptr) {
-				messageQueue.push_back(std::move(preMessage));
-			}
-			mlock.unlock();
-			return;
+			float baseDegrees = options->angleDegrees;
+			float jitterRange = options->angleJitterDegrees;
+			float jitter = (std::rand() / (float)RAND_MAX * 2.0f - 1.0f) * jitterRange;
+			float totalDegrees = baseDegrees + jitter;
+			
+			totalDegrees = std::max(0.0f, std::min(45.0f, totalDegrees));
+			
+			preMessage.angledAngleRad = totalDegrees * (M_PI / 180.0f);
 		}
+		
+		if (preMessage.options != nullptr) {
+			preMessage.combineKey = combineKey;
+			messageQueue.push(combineKey, std::move(preMessage));
+			shedOverload();
+		}
+		mlock.unlock();
+		return;
 	}
 }
 
@@ -105,6 +155,9 @@ void GW2_SCT::ScrollArea::receiveMessage(std::shared_ptr<EventMessage> m) {
 void GW2_SCT::ScrollArea::paint() {
 	std::unique_lock<std::mutex> mlock(messageQueueMutex);
 	if (!options->enabled) { return; }
+	std::shared_ptr<profile_options_struct> profile = Options::get();
+	if (!profile) return;
+	const SkillFilterManager& filterManager = profile->filterManager;
 	
 	const auto frameNow = std::chrono::steady_clock::now();
 	double dt = 0.0;
@@ -113,7 +166,7 @@ void GW2_SCT::ScrollArea::paint() {
 	}
 	lastPaintTs = frameNow;
 	
-	int messagesInStack = std::max(1, Options::get()->messagesInStack);
+	int messagesInStack = std::max(1, Options::hot().messagesInStack);
 	float queuePressure = std::max(0.0f, (float)messageQueue.size() - (float)messagesInStack) / (float)messagesInStack;
 	queuePressure = std::clamp(queuePressure, 0.0f, 3.0f);
 	float targetSpeedMultiplier = 1.0f + queuePressure * options->queueSpeedupFactor;
@@ -130,13 +183,12 @@ void GW2_SCT::ScrollArea::paint() {
 	scrollPhasePx += scrollSpeedEff * (float)dt;
 
 	while (!messageQueue.empty()) {
-		MessagePrerender& m = messageQueue.front();
+		MessagePrerender& m = messageQueue.front().value;
 		
 		if (m.options && m.message) {
-			auto messageData = m.message->getCopyOfFirstData();
-			std::string skillName = messageData && messageData->skillName ? std::string(messageData->skillName) : "";
-			if (m.options->isThresholdExceeded(m.message, messageData ? messageData->skillId : 0, skillName, Options::get()->filterManager)) {
-				messageQueue.pop_front();
+			const MessageData* messageData = m.message->getFirstData();
+			if (m.options->isThresholdExceeded(*m.message, messageData ? messageData->skillId : 0, messageData ? messageData->skillName : 0, filterManager)) {
+				messageQueue.popFront();
 				continue;
 			}
 		}
@@ -144,7 +196,7 @@ void GW2_SCT::ScrollArea::paint() {
 		if (paintedMessages.empty()) {
 			paintedMessages.push_back(std::make_pair(std::move(m), frameNow));
 			paintedMessages.back().first.spawnPhasePx = scrollPhasePx;
-			messageQueue.pop_front();
+			messageQueue.popFront();
 			if (options->textCurve == TextCurve::STATIC) {
 				handleStaticPlacement(paintedMessages.back().first);
 			}
@@ -155,7 +207,7 @@ void GW2_SCT::ScrollArea::paint() {
 			m.ensureExtents();
 			paintedMessages.push_back(std::make_pair(std::move(m), frameNow));
 			paintedMessages.back().first.spawnPhasePx = scrollPhasePx;
-			messageQueue.pop_front();
+			messageQueue.popFront();
 			handleStaticPlacement(paintedMessages.back().first);
 			break;
 		}
@@ -169,7 +221,7 @@ void GW2_SCT::ScrollArea::paint() {
 		if (distPrev >= spaceToClear) {
 			paintedMessages.push_back(std::make_pair(std::move(m), frameNow));
 			paintedMessages.back().first.spawnPhasePx = scrollPhasePx;
-			messageQueue.pop_front();
+			messageQueue.popFront();
 			if (paintedMessages.size() >= 2) {
 				auto newIt = std::prev(paintedMessages.end());
 				auto prevIt = std::prev(newIt);
@@ -190,6 +242,8 @@ void GW2_SCT::ScrollArea::paint() {
 		}
 	}
 
+	paintCollapsedSummary(frameNow);
+
 	float areaOriginY = windowHeight * 0.5f + options->offsetY;
 	float areaTop = areaOriginY;
 	float areaHeight = options->height;
@@ -209,6 +263,93 @@ void GW2_SCT::ScrollArea::paint() {
 	}
 }
 
+void GW2_SCT::ScrollArea::shedOverload() {
+	const HotOptions& hotOptions = Options::hot();
+	if (hotOptions.overloadMode == OverloadMode::OFF) return;
+
+	size_t maxPending = static_cast<size_t>(std::max(1, hotOptions.overloadQueueDepth));
+	while (messageQueue.size() > maxPending) {
+		switch (hotOptions.overloadMode) {
+		case OverloadMode::DROP_LOWEST_VALUE: {
+			auto lowest = std::min_element(messageQueue.begin(), messageQueue.end(), [](const MessageQueue::Entry& a, const MessageQueue::Entry& b) {
+				return std::abs(a.value.message->getCombinedValue()) < std::abs(b.value.message->getCombinedValue());
+			});
+			messageQueue.erase(lowest);
+			OverloadStats::addDropped();
+			break;
+		}
+		case OverloadMode::COLLAPSE:
+			messageQueue.popFront();
+			collapsedMessages++;
+			lastCollapseTs = std::chrono::steady_clock::now();
+			OverloadStats::addCollapsed();
+			break;
+		case OverloadMode::DROP_OLDEST:
+		default:
+			messageQueue.popFront();
+			OverloadStats::addDropped();
+			break;
+		}
+	}
+}
+
+GW2_SCT::ScrollArea::CombineKey GW2_SCT::ScrollArea::combineKeyOf(const message_receiver_options_struct* receiver, MessageCategory category, const MessageData& data) {
+	CombineKey key;
+	key.receiver = receiver;
+	key.skillId = data.skillId;
+	if (category == MessageCategory::PLAYER_IN || category == MessageCategory::PET_IN) {
+		key.entityId = data.entityId;
+	}
+	return key;
+}
+
+size_t GW2_SCT::ScrollArea::CombineKeyHash::operator()(const CombineKey& key) const {
+	uint64_t h = reinterpret_cast<uintptr_t>(key.receiver) * 0x9E3779B97F4A7C15ull;
+	h ^= key.skillId + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+	h ^= key.entityId + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+	return static_cast<size_t>(h);
+}
+
+bool GW2_SCT::ScrollArea::combineWithPainted(const CombineKey& key, MessageCategory category, MessageType type, const std::shared_ptr<const MessageData>& messageData) {
+	// paintedMessages is in display order, so the walk can stop at the first message outside the window
+	auto windowStart = std::chrono::steady_clock::now() - std::chrono::milliseconds(options->combineWindowMs);
+	for (auto it = paintedMessages.rbegin(); it != paintedMessages.rend() && it->second >= windowStart; ++it) {
+		MessagePrerender& painted = it->first;
+		if (painted.forceExpire || !(painted.combineKey == key)) continue;
+		if (!painted.message->tryToCombineWith(category, type, messageData)) continue;
+		// Combining only grows the totals, so a message that passed the thresholds keeps passing them
+		painted.update();
+		return true;
+	}
+	return false;
+}
+
+void GW2_SCT::ScrollArea::paintCollapsedSummary(std::chrono::time_point<std::chrono::steady_clock> frameNow) {
+	if (collapsedMessages == 0) return;
+
+	const float showSeconds = 1.5f;
+	const float fadeSeconds = 0.5f;
+	float age = std::chrono::duration<float>(frameNow - lastCollapseTs).count();
+	if (age > showSeconds || defaultFont == nullptr) {
+		collapsedMessages = 0;
+		return;
+	}
+
+	char text[64];
+	snprintf(text, sizeof(text), langString(LanguageCategory::Option_UI, LanguageKey::General_Overload_More), (unsigned long long)collapsedMessages);
+	float fontSize = Options::hot().defaultFontSize;
+	float alpha = std::clamp((showSeconds - age) / fadeSeconds, 0.f, 1.f);
+	ImVec2 pos(windowWidth * 0.5f + options->offsetX, windowHeight * 0.5f + options->offsetY);
+	defaultFont->bakeGlyphsAtSize(text, fontSize);
+	thread_local std::vector<FontType::GlyphQuad> glyphs;
+	glyphs.clear();
+	defaultFont->layoutAtSize(text, fontSize, glyphs);
+	if (Options::hot().dropShadow) {
+		QuadBatch::addLayout(QuadLayer::SHADOW, glyphs, ImVec2(pos.x + 2, pos.y + 2), ImGui::GetColorU32(ImVec4(0, 0, 0, alpha)));
+	}
+	QuadBatch::addLayout(QuadLayer::TEXT, glyphs, pos, ImGui::GetColorU32(ImVec4(1, 1, 1, alpha)));
+}
+
 bool GW2_SCT::ScrollArea::paintMessage(MessagePrerender& m, __int64 time, float globalSpeedMultiplier) {
 	if (m.forceExpire) {
 		return false;
@@ -236,12 +377,7 @@ bool GW2_SCT::ScrollArea::paintMessage(MessagePrerender& m, __int64 time, float
 		}
 	}
 
-    if (m.prerenderNeeded) m.prerenderText();
-
-    float globalOpacity = 1.0f;
-    if (auto prof = GW2_SCT::Options::get()) {
-        globalOpacity = std::clamp(prof->globalOpacity, 0.0f, 1.0f);
-    }
+    float globalOpacity = std::clamp(GW2_SCT::Options::hot().globalOpacity, 0.0f, 1.0f);
     float areaOpacity = std::clamp(options->opacity, 0.0f, 1.0f);
     float finalOpacity = options->opacityOverrideEnabled ? areaOpacity : globalOpacity;
     float effectiveAlpha = std::clamp(alpha * finalOpacity, 0.0f, 1.0f);
@@ -304,18 +440,19 @@ bool GW2_SCT::ScrollArea::paintMessage(MessagePrerender& m, __int64 time, float
 		}
 	}
 
-    for (TemplateInterpreter::InterpretedText text : m.interpretedText) {
+    bool dropShadow = GW2_SCT::Options::hot().dropShadow;
+    ImU32 blackWithAlpha = ImGui::GetColorU32(ImVec4(0, 0, 0, effectiveAlpha));
+    ImU32 whiteWithAlpha = ImGui::GetColorU32(ImVec4(1, 1, 1, effectiveAlpha));
+    for (const TemplateInterpreter::InterpretedText& text : m.interpretedText) {
         ImVec2 curPos = ImVec2(pos.x + text.offset.x, pos.y + text.offset.y);
         if (text.icon == nullptr) {
-            ImU32 blackWithAlpha = ImGui::GetColorU32(ImVec4(0, 0, 0, effectiveAlpha));
-            if (GW2_SCT::Options::get()->dropShadow) {
-                m.font->drawAtSize(text.str, m.fontSize, ImVec2(curPos.x + 2, curPos.y + 2), blackWithAlpha);
+            if (dropShadow) {
+                QuadBatch::addLayout(QuadLayer::SHADOW, text.glyphs, ImVec2(curPos.x + 2, curPos.y + 2), blackWithAlpha);
             }
-            ImU32 actualCol = text.color & ImGui::GetColorU32(ImVec4(1, 1, 1, effectiveAlpha));
-            m.font->drawAtSize(text.str, m.fontSize, curPos, actualCol);
+            QuadBatch::addLayout(QuadLayer::TEXT, text.glyphs, curPos, text.color & whiteWithAlpha);
         }
         else {
-            text.icon->draw(curPos, text.size, ImGui::GetColorU32(ImVec4(1, 1, 1, effectiveAlpha)));
+            QuadBatch::add(QuadLayer::ICON, text.icon->getTexture(), curPos, text.size, ImVec2(0, 0), ImVec2(1, 1), whiteWithAlpha);
         }
     }
 
@@ -427,61 +564,22 @@ GW2_SCT::ScrollArea::MessagePrerender::MessagePrerender(std::shared_ptr<EventMes
 	category = message->getCategory();
 	type = message->getType();
 	update();
-	templateObserverId = options->outputTemplate.onAssign([this](const std::string& oldVal, const std::string& newVal) { this->update(); });
-	colorObserverId = options->color.onAssign([this](const std::string& oldVal, const std::string& newVal) { this->update(); });
-	fontObserverId = options->font.onAssign([this](const FontId& oldVal, const FontId& newVal) { this->update(); });
-	fontSizeObserverId = options->fontSize.onAssign([this](const float& oldVal, const float& newVal) { this->update(); });
-}
-
-GW2_SCT::ScrollArea::MessagePrerender::MessagePrerender(const MessagePrerender& copy) {
-	message = copy.message;
-	options = copy.options;
-	category = copy.category;
-	type = copy.type;
-	if (copy.prerenderNeeded) {
-		update();
-	}
-	else {
-		str = copy.str;
-		font = copy.font;
-		fontSize = copy.fontSize;
-		options = copy.options;
-		interpretedText = std::vector<TemplateInterpreter::InterpretedText>(copy.interpretedText);
-		interpretedTextWidth = copy.interpretedTextWidth;
-		prerenderNeeded = copy.prerenderNeeded;
-	}
-	
-	angledSign = copy.angledSign;
-	angledAngleRad = copy.angledAngleRad;
-	spawnYOffsetPx = copy.spawnYOffsetPx;
-	spawnPhasePx = copy.spawnPhasePx;
-	
-	templateObserverId = options->outputTemplate.onAssign([this](const std::string& oldVal, const std::string& newVal) { this->update(); });
-	colorObserverId = options->color.onAssign([this](const std::string& oldVal, const std::string& newVal) { this->update(); });
-	fontObserverId = options->font.onAssign([this](const FontId& oldVal, const FontId& newVal) { this->update(); });
-	fontSizeObserverId = options->fontSize.onAssign([this](const float& oldVal, const float& newVal) { this->update(); });
-}
-
-GW2_SCT::ScrollArea::MessagePrerender::~MessagePrerender() {
-	options->outputTemplate.removeOnAssign(templateObserverId);
-	options->color.removeOnAssign(colorObserverId);
-	options->font.removeOnAssign(fontObserverId);
-	options->fontSize.removeOnAssign(fontSizeObserverId);
 }
 
 void GW2_SCT::ScrollArea::MessagePrerender::update() {
+	renderGeneration = options->getRenderGeneration();
 	if (message.get() == nullptr) {
 		LOG("ERROR: calling update on pre-render without message");
 		str = "";
 		prerenderNeeded = false;
 		return;
 	}
-	str = message->getStringForOptions(options);
+	message->writeStringForOptions(options, str);
 	font = getFontType(options->font);
 	fontSize = options->fontSize;
 	if (fontSize < 0) {
-		if (floatEqual(fontSize, -1.f)) fontSize = GW2_SCT::Options::get()->defaultFontSize;
-		else if (floatEqual(fontSize, -2.f)) fontSize = GW2_SCT::Options::get()->defaultCritFontSize;
+		if (floatEqual(fontSize, -1.f)) fontSize = GW2_SCT::Options::hot().defaultFontSize;
+		else if (floatEqual(fontSize, -2.f)) fontSize = GW2_SCT::Options::hot().defaultCritFontSize;
 	}
 	font->bakeGlyphsAtSize(str, fontSize);
 	prerenderNeeded = true;
@@ -503,6 +601,8 @@ void GW2_SCT::ScrollArea::MessagePrerender::prerenderText() {
 }
 
 void GW2_SCT::ScrollArea::MessagePrerender::ensureExtents() {
+	// Picks up edits of the receiver's template, color or font made since the last render
+	if (renderGeneration != options->getRenderGeneration()) update();
 	if (messageHeight > 0.0f && !prerenderNeeded) return;
 	
 	if (prerenderNeeded) prerenderText();
@@ -532,5 +632,5 @@ void GW2_SCT::ScrollArea::MessagePrerender::ensureExtents() {
 }
 
 float GW2_SCT::ScrollArea::getEffectiveScrollSpeed() const {
-	return (options->customScrollSpeed > 0.0f) ? options->customScrollSpeed : Options::get()->scrollSpeed;
+	return (options->customScrollSpeed > 0.0f) ? options->customScrollSpeed : Options::hot().scrollSpeed;
 }
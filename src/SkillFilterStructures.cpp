@@ -1,4 +1,5 @@
 #include "SkillFilterStructures.h"
+#include <algorithm>
 
 namespace GW2_SCT {
 	void to_json(nlohmann::json& j, const FilterAction& action) {
@@ -90,4 +91,103 @@ namespace GW2_SCT {
 		}
 		j.at("filterSet").get_to(filterSet.filterSet);
 	}
-}
+
+	void CompiledSkillFilter::compile(const std::vector<std::string>& filterSetNames, const SkillFilterManager& filterManager) {
+		ids.clear();
+		names.clear();
+		ranges.clear();
+		defaultBlocks = false;
+
+		std::vector<IdRun> rangeFilters;
+		for (const std::string& filterSetName : filterSetNames) {
+			auto filterSet = filterManager.getFilterSet(filterSetName);
+			if (!filterSet) continue;
+
+			if (filterSet->filterSet.defaultAction == FilterAction::BLOCK) {
+				defaultBlocks = true;
+			}
+			for (const auto& filter : filterSet->filterSet.filters) {
+				uint8_t action = filter.action == FilterAction::ALLOW ? ALLOWS : BLOCKS;
+				switch (filter.type) {
+				case FilterType::SKILL_ID:
+					ids[filter.skillId] |= action;
+					break;
+				case FilterType::SKILL_NAME: {
+					auto it = names.find(std::string_view(filter.skillName));
+					if (it == names.end()) it = names.emplace(filter.skillName, 0).first;
+					it->second |= action;
+					break;
+				}
+				case FilterType::SKILL_ID_RANGE:
+					if (filter.idRange.start <= filter.idRange.end) {
+						rangeFilters.push_back({ filter.idRange.start, filter.idRange.end, action });
+					}
+					break;
+				}
+			}
+		}
+		if (rangeFilters.empty()) return;
+
+		// Cut the id space at every range start and behind every range end, each piece is covered by a fixed set of filters
+		std::vector<uint64_t> cuts;
+		for (const IdRun& range : rangeFilters) {
+			cuts.push_back(range.start);
+			cuts.push_back((uint64_t)range.end + 1);
+		}
+		std::sort(cuts.begin(), cuts.end());
+		cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+		for (size_t i = 0; i + 1 < cuts.size(); i++) {
+			uint32_t start = (uint32_t)cuts[i];
+			uint32_t end = (uint32_t)(cuts[i + 1] - 1);
+			uint8_t actions = 0;
+			for (const IdRun& range : rangeFilters) {
+				if (range.start <= start && end <= range.end) actions |= range.actions;
+			}
+			if (actions == 0) continue;
+			if (!ranges.empty() && ranges.back().actions == actions && (uint64_t)ranges.back().end + 1 == start) {
+				ranges.back().end = end;
+			}
+			else {
+				ranges.push_back({ start, end, actions });
+			}
+		}
+	}
+
+	bool CompiledSkillFilter::isFiltered(uint32_t skillId, std::string_view skillName) const {
+		// A level decides once any of its filters matches, and then only blocks without a matching ALLOW
+		if (!ids.empty()) {
+			auto it = ids.find(skillId);
+			if (it != ids.end()) return !(it->second & ALLOWS);
+		}
+		if (!names.empty()) {
+			auto it = names.find(skillName);
+			if (it != names.end()) return !(it->second & ALLOWS);
+		}
+		if (!ranges.empty()) {
+			auto it = std::upper_bound(ranges.begin(), ranges.end(), skillId, [](uint32_t id, const IdRun& run) { return id < run.start; });
+			if (it != ranges.begin() && skillId <= std::prev(it)->end) return !(std::prev(it)->actions & ALLOWS);
+		}
+		return defaultBlocks;
+	}
+
+	bool SkillFilterVerdictCache::find(uint32_t skillId, InternedString skillName, bool& filtered) const {
+		lookups.fetch_add(1, std::memory_order_relaxed);
+		const Entry& entry = entries[slotOf(skillId)];
+		if (!entry.used || entry.skillId != skillId || entry.skillName != skillName) return false;
+		hits.fetch_add(1, std::memory_order_relaxed);
+		filtered = entry.filtered;
+		return true;
+	}
+
+	void SkillFilterVerdictCache::store(uint32_t skillId, InternedString skillName, bool filtered) {
+		entries[slotOf(skillId)] = { skillId, skillName, filtered, true };
+	}
+
+	SkillFilterCacheStats SkillFilterVerdictCache::getStats() {
+		SkillFilterCacheStats stats;
+		stats.lookups = lookups.load(std::memory_order_relaxed);
+		stats.hits = hits.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
\ No newline at end of file
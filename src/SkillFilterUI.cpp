@@ -27,6 +27,12 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 
 	static std::string selectedFilterSet = "";
 
+	// Filter edits in place have to reach the filters compiled into the receivers
+	auto filtersChanged = [&currentProfile]() {
+		currentProfile->filterManager.markChanged();
+		Options::requestSave();
+	};
+
 	// Left pane - Filter Set List
 	{
 		ImGui::BeginChild("filter_sets_list", ImVec2(ImGui::GetWindowWidth() * 0.3f, 0), true);
@@ -61,10 +67,15 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 				currentProfile->filterManager.createFilterSet(newFilterSetName);
 				selectedFilterSet = newFilterSetName;
 				memset(newFilterSetName, 0, sizeof(newFilterSetName));
-				Options::requestSave();
+				filtersChanged();
 			}
 		}
 
+		ImGui::Spacing();
+		SkillFilterCacheStats cacheStats = SkillFilterVerdictCache::getStats();
+		ImGui::TextDisabled(langString(LanguageCategory::Skill_Filter_Option_UI, LanguageKey::Filter_Cache_Hit_Rate),
+			cacheStats.lookups > 0 ? 100.0 * cacheStats.hits / cacheStats.lookups : 0.0, (unsigned long long)cacheStats.lookups);
+
 		ImGui::EndChild();
 	}
 
@@ -125,7 +136,7 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 
 							selectedFilterSet = newName;
 
-							Options::requestSave();
+							filtersChanged();
 							ImGui::CloseCurrentPopup();
 						}
 					}
@@ -169,7 +180,7 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 						}
 						currentProfile->filterManager.removeFilterSet(filterSet->name);
 						selectedFilterSet = "";
-						Options::requestSave();
+						filtersChanged();
 						ImGui::CloseCurrentPopup();
 					}
 					ImGui::SameLine();
@@ -195,12 +206,12 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 				int defaultAction = static_cast<int>(filterSet->filterSet.defaultAction);
 				if (ImGui::RadioButton(langString(LanguageCategory::Skill_Filter_Option_UI, LanguageKey::Default_Action_Allow), &defaultAction, 0)) {
 					filterSet->filterSet.defaultAction = FilterAction::ALLOW;
-					Options::requestSave();
+					filtersChanged();
 				}
 				ImGui::SameLine();
 				if (ImGui::RadioButton(langString(LanguageCategory::Skill_Filter_Option_UI, LanguageKey::Default_Action_Block), &defaultAction, 1)) {
 					filterSet->filterSet.defaultAction = FilterAction::BLOCK;
-					Options::requestSave();
+					filtersChanged();
 				}
 
 				ImGui::Separator();
@@ -236,7 +247,7 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 						std::string actionCombo = std::string(langString(LanguageCategory::Skill_Filter_Option_UI, LanguageKey::Default_Action_Allow)) + '\0' + std::string(langString(LanguageCategory::Skill_Filter_Option_UI, LanguageKey::Default_Action_Block)) + '\0';
 						if (ImGui::Combo("##action", &action, actionCombo.c_str())) {
 						it->action = static_cast<FilterAction>(action);
-						Options::requestSave();
+						filtersChanged();
 						}
 					}
 
@@ -249,7 +260,7 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 						std::string typeCombo = GW2_SCT::SkillFilterUI::getFilterTypeSelectionString();
 						if (ImGui::Combo("##type", &type, typeCombo.c_str())) {
 						it->type = static_cast<FilterType>(type);
-						Options::requestSave();
+						filtersChanged();
 						}
 					}
 
@@ -260,28 +271,28 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 					case FilterType::SKILL_ID: {
 						ImGui::SetNextItemWidth(150);
 						if (ImGui::InputScalar("##value", ImGuiDataType_U32, &it->skillId)) {
-							Options::requestSave();
+							filtersChanged();
 						}
 						break;
 					}
 					case FilterType::SKILL_NAME: {
 						ImGui::SetNextItemWidth(200);
 						if (ImGui::InputText("##value", &it->skillName)) {
-							Options::requestSave();
+							filtersChanged();
 						}
 						break;
 					}
 					case FilterType::SKILL_ID_RANGE: {
 						ImGui::SetNextItemWidth(100);
 						if (ImGui::InputScalar("##start", ImGuiDataType_U32, &it->idRange.start)) {
-							Options::requestSave();
+							filtersChanged();
 						}
 						ImGui::SameLine();
 						ImGui::Text("%s", langString(LanguageCategory::Skill_Filter_Option_UI, LanguageKey::Range_To_Word));
 						ImGui::SameLine();
 						ImGui::SetNextItemWidth(100);
 						if (ImGui::InputScalar("##end", ImGuiDataType_U32, &it->idRange.end)) {
-							Options::requestSave();
+							filtersChanged();
 						}
 						break;
 					}
@@ -294,7 +305,7 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 
 					if (shouldDelete) {
 						it = filterSet->filterSet.filters.erase(it);
-						Options::requestSave();
+						filtersChanged();
 					}
 					else {
 						++it;
@@ -318,7 +329,7 @@ void GW2_SCT::SkillFilterUI::paintUI() {
 						: FilterAction::ALLOW;
 					newFilter.skillId = 0;
 					filterSet->filterSet.filters.push_back(newFilter);
-					Options::requestSave();
+					filtersChanged();
 					}
 				}
 
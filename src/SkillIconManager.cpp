@@ -575,22 +575,20 @@ GW2_SCT::SkillIcon* GW2_SCT::SkillIconManager::getIcon(uint32_t skillID) {
 }
 
 ImVec2 GW2_SCT::SkillIcon::draw(ImVec2 pos, ImVec2 size, ImU32 color) {
-    SkillIconDisplayType requestedDisplayType = Options::get()->skillIconsDisplayType;
-    if (!texturesCreated[requestedDisplayType]) {
-        requestTextureCreation(requestedDisplayType);
-    }
-    if (textures[requestedDisplayType] == nullptr) {
+    Texture* texture = getTexture();
+    if (texture == nullptr) {
         return ImVec2(0, 0);
     }
+    texture->draw(pos, size, color);
+    return size;
+}
 
-    ImVec2 end(pos.x + size.x, pos.y + size.y);
-    if (textures[requestedDisplayType] != nullptr) {
-        textures[requestedDisplayType]->draw(pos, size, color);
-    }
-    else {
-        return ImVec2(0, 0);
+GW2_SCT::Texture* GW2_SCT::SkillIcon::getTexture() {
+    SkillIconDisplayType requestedDisplayType = Options::get()->skillIconsDisplayType;
+    if (!texturesCreated[requestedDisplayType]) {
+        requestTextureCreation(requestedDisplayType);
     }
-    return size;
+    return textures[requestedDisplayType];
 }
 GW2_SCT::SkillIcon::SkillIcon(std::shared_ptr<std::vector<BYTE>> fileData, uint32_t skillID)
 	: fileData(fileData), skillID(skillID) {}
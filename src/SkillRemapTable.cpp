@@ -0,0 +1,72 @@
+#include "SkillRemapTable.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Common.h"
+
+GW2_SCT::SkillRemapDiagnostics GW2_SCT::SkillRemapTable::compile(const std::map<uint32_t, uint32_t>& remaps) {
+	SkillRemapDiagnostics diagnostics;
+	std::map<uint32_t, uint32_t> resolved;
+
+	for (const auto& [from, to] : remaps) {
+		if (from == to) {
+			LOG("Ignoring remap of id ", from, " to itself");
+			diagnostics.selfMaps++;
+			continue;
+		}
+
+		// Follow the chain until an id that is not remapped; revisiting an id means the chain loops
+		std::vector<uint32_t> visited = { from };
+		uint32_t target = to;
+		bool cycle = false;
+		for (auto next = remaps.find(target); next != remaps.end() && next->second != target; next = remaps.find(target)) {
+			cycle = std::find(visited.begin(), visited.end(), target) != visited.end();
+			visited.push_back(target);
+			if (cycle) break;
+			target = next->second;
+		}
+		size_t hops = visited.size();
+		std::string path;
+		for (uint32_t id : visited) path += std::to_string(id) + " -> ";
+		path += cycle ? "..." : std::to_string(target);
+
+		if (cycle) {
+			LOG("Dropping remap of id ", from, ", its chain loops: ", path);
+			diagnostics.cycles++;
+			continue;
+		}
+		if (hops > 1) {
+			LOG("Resolved remap chain ", path);
+			diagnostics.chains++;
+		}
+		if (hops > diagnostics.longestChain) diagnostics.longestChain = hops;
+		resolved[from] = target;
+	}
+
+	dense.clear();
+	sparse.clear();
+	entries = resolved.size();
+	diagnostics.entries = entries;
+	if (resolved.empty()) return diagnostics;
+
+	firstId = resolved.begin()->first;
+	uint32_t denseSpan = std::min(resolved.rbegin()->first - firstId, maxDenseSpan - 1) + 1;
+	dense.resize(denseSpan);
+	for (uint32_t i = 0; i < denseSpan; i++) {
+		dense[i] = firstId + i;
+	}
+	for (const auto& [from, to] : resolved) {
+		if (from - firstId < denseSpan) dense[from - firstId] = to;
+		else sparse.emplace_back(from, to);
+	}
+	if (!sparse.empty()) {
+		LOG("Skill remap ids span more than ", maxDenseSpan, " ids, ", sparse.size(), " remaps use the slower sorted lookup");
+	}
+	return diagnostics;
+}
+
+uint32_t GW2_SCT::SkillRemapTable::remapSparse(uint32_t id) const {
+	auto found = std::lower_bound(sparse.begin(), sparse.end(), id, [](const std::pair<uint32_t, uint32_t>& entry, uint32_t id) { return entry.first < id; });
+	if (found != sparse.end() && found->first == id) return found->second;
+	return id;
+}
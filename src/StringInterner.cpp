@@ -0,0 +1,250 @@
+#include "StringInterner.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+	struct InternedEntry {
+		const char* str = nullptr;
+		uint32_t length = 0;
+	};
+
+	constexpr uint32_t entriesPerChunkShift = 10;
+	constexpr uint32_t entriesPerChunk = 1u << entriesPerChunkShift;
+	constexpr uint32_t maxChunks = 256;
+	constexpr size_t textBlockSize = 64 * 1024;
+	constexpr uint32_t keyedSlotsShift = 12;
+	constexpr size_t keyedSlots = size_t(1) << keyedSlotsShift;
+
+	using KeyedSlots = std::array<std::atomic<GW2_SCT::InternedString>, keyedSlots>;
+
+	struct InternerState {
+		std::mutex writeMutex;
+		// Text of all interned strings, null-terminated. Blocks are never freed or moved before unload.
+		std::vector<std::unique_ptr<char[]>> textBlocks;
+		char* textCursor = nullptr;
+		size_t textRemaining = 0;
+		// Open addressing table of handles by content, 0 marks a free slot. Only used under writeMutex.
+		std::vector<GW2_SCT::InternedString> lookup;
+		// Handle last interned for a skill or agent id, by a hash of the id. Only hints, a hit is confirmed by
+		// comparing the name, so they can be read without locking and slots may be shared or overwritten.
+		KeyedSlots skillKeys = {};
+		KeyedSlots agentKeys = {};
+		std::array<std::atomic<InternedEntry*>, maxChunks> chunks = {};
+		std::atomic<uint32_t> count = 1; // handle 0 is the empty string
+		size_t stringBytes = 0;
+		std::atomic<uint64_t> lookups = 0;
+		std::atomic<uint64_t> hits = 0;
+		std::atomic<uint64_t> keyedHits = 0;
+
+		~InternerState() {
+			for (auto& chunk : chunks) {
+				delete[] chunk.load(std::memory_order_relaxed);
+			}
+		}
+	};
+
+	// Function-local so that static initializers in other translation units can already intern.
+	InternerState& state() {
+		static InternerState s;
+		return s;
+	}
+
+	const InternedEntry* findEntry(GW2_SCT::InternedString handle) {
+		uint32_t chunkIndex = handle >> entriesPerChunkShift;
+		if (handle == 0 || chunkIndex >= maxChunks) return nullptr;
+		InternedEntry* chunk = state().chunks[chunkIndex].load(std::memory_order_acquire);
+		if (chunk == nullptr) return nullptr;
+		return &chunk[handle & (entriesPerChunk - 1)];
+	}
+
+	bool isEmpty(const char* str) {
+		return str == nullptr || *str == '\0';
+	}
+
+	size_t skillSlotOf(uint32_t skillId) {
+		return (skillId * 2654435761u) >> (32 - keyedSlotsShift);
+	}
+
+	size_t agentSlotOf(uint64_t agentId) {
+		return (agentId * 0x9E3779B97F4A7C15ull) >> (64 - keyedSlotsShift);
+	}
+}
+
+namespace {
+	// Caller holds writeMutex
+	void ensureChunk(InternerState& s, uint32_t chunkIndex) {
+		if (s.chunks[chunkIndex].load(std::memory_order_relaxed) == nullptr) {
+			s.chunks[chunkIndex].store(new InternedEntry[entriesPerChunk], std::memory_order_release);
+		}
+	}
+
+	// Caller holds writeMutex
+	void ensureText(InternerState& s, size_t bytes) {
+		if (s.textRemaining >= bytes) return;
+		size_t blockSize = std::max(bytes, textBlockSize);
+		s.textBlocks.push_back(std::make_unique<char[]>(blockSize));
+		s.textCursor = s.textBlocks.back().get();
+		s.textRemaining = blockSize;
+	}
+
+	// Caller holds writeMutex
+	void insertLookup(std::vector<GW2_SCT::InternedString>& lookup, std::string_view str, GW2_SCT::InternedString handle) {
+		size_t mask = lookup.size() - 1;
+		for (size_t i = std::hash<std::string_view>{}(str) & mask;; i = (i + 1) & mask) {
+			if (lookup[i] == 0) {
+				lookup[i] = handle;
+				return;
+			}
+		}
+	}
+
+	// Caller holds writeMutex. Keeps the table at most half full.
+	void ensureLookupCapacity(InternerState& s, size_t strings) {
+		size_t size = s.lookup.empty() ? 1024 : s.lookup.size();
+		while (size < strings * 2) size *= 2;
+		if (size == s.lookup.size()) return;
+
+		std::vector<GW2_SCT::InternedString> grown(size, 0);
+		for (GW2_SCT::InternedString handle : s.lookup) {
+			if (handle != 0) insertLookup(grown, GW2_SCT::StringInterner::view(handle), handle);
+		}
+		s.lookup = std::move(grown);
+	}
+
+	// Caller holds writeMutex
+	GW2_SCT::InternedString internLocked(InternerState& s, std::string_view str) {
+		s.lookups.fetch_add(1, std::memory_order_relaxed);
+		ensureLookupCapacity(s, s.count.load(std::memory_order_relaxed));
+
+		size_t mask = s.lookup.size() - 1;
+		size_t slot = std::hash<std::string_view>{}(str) & mask;
+		for (; s.lookup[slot] != 0; slot = (slot + 1) & mask) {
+			if (GW2_SCT::StringInterner::view(s.lookup[slot]) == str) {
+				s.hits.fetch_add(1, std::memory_order_relaxed);
+				return s.lookup[slot];
+			}
+		}
+
+		GW2_SCT::InternedString handle = s.count.load(std::memory_order_relaxed);
+		uint32_t chunkIndex = handle >> entriesPerChunkShift;
+		if (chunkIndex >= maxChunks) {
+			return 0;
+		}
+		ensureChunk(s, chunkIndex);
+		ensureText(s, str.size() + 1);
+
+		char* stored = s.textCursor;
+		std::memcpy(stored, str.data(), str.size());
+		stored[str.size()] = '\0';
+		s.textCursor += str.size() + 1;
+		s.textRemaining -= str.size() + 1;
+
+		InternedEntry* chunk = s.chunks[chunkIndex].load(std::memory_order_relaxed);
+		chunk[handle & (entriesPerChunk - 1)] = { stored, static_cast<uint32_t>(str.size()) };
+		s.lookup[slot] = handle;
+		s.stringBytes += str.size() + 1;
+		s.count.store(handle + 1, std::memory_order_release);
+		return handle;
+	}
+
+	// Lock free, 0 if the slot does not hold the name
+	GW2_SCT::InternedString findKeyed(InternerState& s, const std::atomic<GW2_SCT::InternedString>& slot, const char* name) {
+		GW2_SCT::InternedString handle = slot.load(std::memory_order_acquire);
+		if (handle == 0 || GW2_SCT::StringInterner::view(handle) != name) return 0;
+		s.lookups.fetch_add(1, std::memory_order_relaxed);
+		s.hits.fetch_add(1, std::memory_order_relaxed);
+		s.keyedHits.fetch_add(1, std::memory_order_relaxed);
+		return handle;
+	}
+
+	// Caller holds writeMutex
+	GW2_SCT::InternedString internKeyedLocked(InternerState& s, std::atomic<GW2_SCT::InternedString>& slot, const char* name) {
+		GW2_SCT::InternedString handle = internLocked(s, name);
+		slot.store(handle, std::memory_order_release);
+		return handle;
+	}
+}
+
+GW2_SCT::InternedString GW2_SCT::StringInterner::intern(const char* str) {
+	if (str == nullptr) return 0;
+	return intern(std::string_view(str));
+}
+
+GW2_SCT::InternedString GW2_SCT::StringInterner::intern(std::string_view str) {
+	if (str.empty()) return 0;
+
+	InternerState& s = state();
+	std::lock_guard<std::mutex> lock(s.writeMutex);
+	return internLocked(s, str);
+}
+
+GW2_SCT::EventNames GW2_SCT::StringInterner::internEventNames(uint32_t skillId, const char* skillName, uint64_t srcId, const char* srcName, uint64_t dstId, const char* dstName) {
+	InternerState& s = state();
+	std::atomic<InternedString>& skillSlot = s.skillKeys[skillSlotOf(skillId)];
+	std::atomic<InternedString>& srcSlot = s.agentKeys[agentSlotOf(srcId)];
+	std::atomic<InternedString>& dstSlot = s.agentKeys[agentSlotOf(dstId)];
+
+	EventNames names;
+	bool skillMissed = !isEmpty(skillName) && (names.skillName = findKeyed(s, skillSlot, skillName)) == 0;
+	bool srcMissed = !isEmpty(srcName) && (names.srcName = findKeyed(s, srcSlot, srcName)) == 0;
+	bool dstMissed = !isEmpty(dstName) && (names.dstName = findKeyed(s, dstSlot, dstName)) == 0;
+	if (!skillMissed && !srcMissed && !dstMissed) return names;
+
+	std::lock_guard<std::mutex> lock(s.writeMutex);
+	if (skillMissed) names.skillName = internKeyedLocked(s, skillSlot, skillName);
+	if (srcMissed) names.srcName = internKeyedLocked(s, srcSlot, srcName);
+	if (dstMissed) names.dstName = internKeyedLocked(s, dstSlot, dstName);
+	return names;
+}
+
+void GW2_SCT::StringInterner::reserve(size_t strings, size_t textBytes) {
+	InternerState& s = state();
+	std::lock_guard<std::mutex> lock(s.writeMutex);
+	size_t total = s.count.load(std::memory_order_relaxed) + strings;
+	size_t lastChunk = std::min<size_t>((total - 1) >> entriesPerChunkShift, maxChunks - 1);
+	for (size_t chunkIndex = 0; chunkIndex <= lastChunk; chunkIndex++) {
+		ensureChunk(s, (uint32_t)chunkIndex);
+	}
+	ensureText(s, textBytes);
+	ensureLookupCapacity(s, total);
+}
+
+std::string_view GW2_SCT::StringInterner::view(InternedString handle) {
+	const InternedEntry* entry = findEntry(handle);
+	if (entry == nullptr || entry->str == nullptr) return std::string_view();
+	return std::string_view(entry->str, entry->length);
+}
+
+const char* GW2_SCT::StringInterner::c_str(InternedString handle) {
+	const InternedEntry* entry = findEntry(handle);
+	return entry != nullptr ? entry->str : nullptr;
+}
+
+size_t GW2_SCT::StringInterner::size() {
+	return state().count.load(std::memory_order_acquire) - 1;
+}
+
+GW2_SCT::StringInternerStats GW2_SCT::StringInterner::getStats() {
+	InternerState& s = state();
+	std::lock_guard<std::mutex> lock(s.writeMutex);
+	StringInternerStats stats;
+	stats.strings = s.count.load(std::memory_order_relaxed) - 1;
+	stats.stringBytes = s.stringBytes;
+	size_t allocatedChunks = 0;
+	for (auto& chunk : s.chunks) {
+		if (chunk.load(std::memory_order_relaxed) != nullptr) allocatedChunks++;
+	}
+	stats.tableBytes = allocatedChunks * entriesPerChunk * sizeof(InternedEntry)
+		+ s.lookup.size() * sizeof(InternedString)
+		+ sizeof(s.skillKeys) + sizeof(s.agentKeys);
+	stats.lookups = s.lookups.load(std::memory_order_relaxed);
+	stats.hits = s.hits.load(std::memory_order_relaxed);
+	stats.keyedHits = s.keyedHits.load(std::memory_order_relaxed);
+	return stats;
+}
@@ -1,9 +1,15 @@
 #include "TemplateInterpreter.h"
 #include <string>
 #include <vector>
-#include <regex>
 #include "Common.h"
 #include "Options.h"
+#include "TemplateParser.h"
+
+namespace {
+	ImU32 rgbToColor(int rgb) {
+		return ImGui::GetColorU32(ImVec4(((rgb >> 16) & 0xFF) / 255.f, ((rgb >> 8) & 0xFF) / 255.f, (rgb & 0xFF) / 255.f, 1.f));
+	}
+}
 
 ImVec2 CalcTextSizeWithFontSize(const char* text, ImFont* font, float font_size)
 {
@@ -54,215 +60,63 @@ ImVec2 getTextSize(const char* t, GW2_SCT::FontType* font, float fontSize, bool
 	return font->calcRequiredSpaceForTextAtSize(currentText, fontSize);
 }
 
-bool GW2_SCT::TemplateInterpreter::validate(std::string t, std::map<char, std::string> params) {
-	int openColors = 0;
-	std::vector<std::string> currentCommands;
-	std::string tempText;
-
-	for (auto it = t.begin(); it != t.end(); it++) {
-		switch (*it)
-		{
-		case ']':
-			it++;
-			if (it == t.end() || *it != ']') return false;
-			break;
-		case '[':
-			it++;
-			if (it == t.end()) return false;
-			switch (*it)
-			{
-			case '[':
-				break;
-			case '/':
-				it++;
-				if (it == t.end()) return false;
-				tempText = "";
-				while (it != t.end() && *it != ']') {
-					tempText += *it;
-					it++;
-				}
-				if (it == t.end()) return false;
-				if (currentCommands.empty()) return false;
-				if (tempText.compare(currentCommands.back()) != 0) return false;
-				currentCommands.pop_back();
-				if (tempText == "col") {
-					openColors--;
-				}
-				break;
-			default:
-				tempText = "";
-				while (it != t.end() && *it != '=' && *it != ']') {
-					tempText += *it;
-					it++;
-				}
-				if (it == t.end()) return false;
-				currentCommands.push_back(tempText);
-				if (tempText == "col") {
-					tempText = "";
-					if (*it != '=') return false;
-					it++;
-					while (it != t.end() && *it != ']') {
-						tempText += *it;
-						it++;
-					}
-					if (it == t.end()) return false;
-					if (std::regex_match(tempText, std::regex("(%c|[0-9A-F]{6})"))) {
-						openColors++;
-					}
-					else {
-						return false;
-					}
-				}
-				else if (tempText == "icon") {
-					tempText = "";
-					if (*it != '=') return false;
-					it++;
-					while (it != t.end() && *it != ']') {
-						tempText += *it;
-						it++;
-					}
-					if (it == t.end()) return false;
-					if (std::regex_match(tempText, std::regex("[0-9]+"))) {
-						openColors++;
-					}
-					else {
-						return false;
-					}
-				}
-				else {
-					return false;
-				}
-				break;
-			}
-			break;
-		case '%':
-			it++;
-			if (it == t.end()) return false;
-			if (*it != '%' && params.find(*it) == params.end()) {
-				return false;
-			}
-			break;
-		}
-	}
-	return openColors == 0;
+bool GW2_SCT::TemplateInterpreter::validate(const std::string& t, const std::map<char, std::string>& params) {
+	return TemplateParser::parse(t, TemplateSyntax::TEMPLATE, &params).valid();
 }
 
 const std::vector<GW2_SCT::TemplateInterpreter::InterpretedText> emptyInterpreted = {};
 
-std::vector<GW2_SCT::TemplateInterpreter::InterpretedText> GW2_SCT::TemplateInterpreter::interpret(GW2_SCT::FontType* font, float fontSize, ImU32 defaultColor, std::string t) {
+std::vector<GW2_SCT::TemplateInterpreter::InterpretedText> GW2_SCT::TemplateInterpreter::interpret(GW2_SCT::FontType* font, float fontSize, ImU32 defaultColor, const std::string& t) {
+	// Reused between calls so parsing does not allocate once warmed up
+	thread_local TemplateParseResult parsed;
+	TemplateParser::parse(t, TemplateSyntax::RENDERED, nullptr, parsed);
+	if (!parsed.valid()) return emptyInterpreted;
+
 	std::vector<GW2_SCT::TemplateInterpreter::InterpretedText> interpreted;
-	std::vector<std::string> currentCommands;
 	std::vector<ImU32> colors{ defaultColor };
-	std::string tempText;
 	std::string currentText = "";
 	ImVec2 currentOffset = ImVec2(0.f, 0.f);
 
-	for (auto it = t.begin(); it != t.end(); it++) {
-		switch (*it)
-		{
-		case ']':
-			it++;
-			if (it == t.end() || *it != ']') return emptyInterpreted;
-			currentText += *it;
+	auto flushText = [&]() {
+		if (currentText != "") {
+			ImVec2 s = getTextSize(currentText.c_str(), font, fontSize, false);
+			interpreted.push_back({ currentText, s, currentOffset, colors.back() });
+			font->layoutAtSize(currentText, fontSize, interpreted.back().glyphs);
+			currentOffset.x += s.x;
+			currentText = "";
+		}
+	};
+
+	for (const TemplateNode& node : parsed.nodes) {
+		switch (node.type) {
+		case TemplateNode::Type::TEXT:
+			currentText += node.text;
 			break;
-		case '[':
-			it++;
-			if (it == t.end()) return emptyInterpreted;
-			switch (*it)
-			{
-			case '[':
-				currentText += *it;
-				break;
-			case '/':
-				it++;
-				if (it == t.end()) return emptyInterpreted;
-				tempText = "";
-				while (it != t.end() && *it != ']') {
-					tempText += *it;
-					it++;
-				}
-				if (it == t.end()) return emptyInterpreted;
-				if (currentCommands.empty()) return emptyInterpreted;
-				if (tempText.compare(currentCommands.back()) != 0) return emptyInterpreted;
-				currentCommands.pop_back();
-				if (tempText == "col") {
-					if (currentText != "") {
-						ImVec2 s = getTextSize(currentText.c_str(), font, fontSize, false);
-						interpreted.push_back({ currentText, s, currentOffset, colors.back() });
-						currentOffset.x += s.x;
-						currentText = "";
-					}
-					colors.pop_back();
-				}
-				else {
-					currentText = "";
-				}
-				break;
-			default:
-				if (currentText != "") {
-					ImVec2 s = getTextSize(currentText.c_str(), font, fontSize, false);
-					interpreted.push_back({ currentText, s, currentOffset, colors.back() });
-					currentOffset.x += s.x;
-					currentText = "";
-				}
-				tempText = "";
-				while (it != t.end() && *it != '=' && *it != ']') {
-					tempText += *it;
-					it++;
-				}
-				if (it == t.end()) return emptyInterpreted;
-				currentCommands.push_back(tempText);
-				if (tempText == "col") {
-					tempText = "";
-					if (*it != '=') return emptyInterpreted;
-					it++;
-					while (it != t.end() && *it != ']') {
-						tempText += *it;
-						it++;
-					}
-					if (it == t.end()) return emptyInterpreted;
-					if (std::regex_match(tempText, std::regex("([0-9A-F]{6})"))) {
-						colors.push_back(stoc(tempText));
-					}
-					else {
-						return emptyInterpreted;
-					}
-				}
-				else if (tempText == "icon") {
-					tempText = "";
-					if (*it != '=') return emptyInterpreted;
-					it++;
-					while (it != t.end() && *it != ']') {
-						tempText += *it;
-						it++;
-					}
-					if (it == t.end()) return emptyInterpreted;
-					if (std::regex_match(tempText, std::regex("([0-9]+)"))) {
-						SkillIcon* icon = SkillIconManager::getIcon(std::stoi(tempText.c_str()));
-						if (icon != nullptr) {
-							interpreted.push_back({ "", ImVec2(fontSize, fontSize), currentOffset, defaultColor, icon});
-							currentOffset.x += fontSize;
-						}
-					}
-					else {
-						return emptyInterpreted;
-					}
-				}
-				else {
-					return emptyInterpreted;
-				}
-				break;
+		case TemplateNode::Type::COLOR_BEGIN:
+			flushText();
+			colors.push_back(rgbToColor(node.rgb));
+			break;
+		case TemplateNode::Type::COLOR_END:
+			flushText();
+			colors.pop_back();
+			break;
+		case TemplateNode::Type::ICON_BEGIN: {
+			flushText();
+			SkillIcon* icon = SkillIconManager::getIcon(node.iconId);
+			if (icon != nullptr) {
+				interpreted.push_back({ "", ImVec2(fontSize, fontSize), currentOffset, defaultColor, icon });
+				currentOffset.x += fontSize;
 			}
 			break;
-		default:
-			currentText += *it;
+		}
+		case TemplateNode::Type::ICON_END:
+			// Text inside an icon tag is not shown
+			currentText = "";
+			break;
+		case TemplateNode::Type::PARAMETER:
+			break;
 		}
 	}
-	if (currentText != "") {
-		ImVec2 s = getTextSize(currentText.c_str(), font, fontSize, false);
-		interpreted.push_back({ currentText, s, currentOffset, colors.back() });
-		currentOffset.x += s.x;
-		currentText = "";
-	}
+	flushText();
 	return interpreted;
 }
@@ -0,0 +1,149 @@
+#include "TemplateParser.h"
+#include <charconv>
+
+namespace {
+	int hexDigitValue(char c) {
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+
+	// Markup colors are exactly six upper case hex digits
+	bool parseColor(std::string_view s, int& rgb) {
+		if (s.size() != 6) return false;
+		int value = 0;
+		for (char c : s) {
+			int digit = hexDigitValue(c);
+			if (digit < 0) return false;
+			value = value * 16 + digit;
+		}
+		rgb = value;
+		return true;
+	}
+
+	bool isDigits(std::string_view s) {
+		if (s.empty()) return false;
+		for (char c : s) {
+			if (c < '0' || c > '9') return false;
+		}
+		return true;
+	}
+
+	bool isParameter(char c, const std::map<char, std::string>* parameters) {
+		return parameters == nullptr || parameters->find(c) != parameters->end();
+	}
+}
+
+void GW2_SCT::TemplateParser::parse(std::string_view source, TemplateSyntax syntax, const std::map<char, std::string>* parameters, TemplateParseResult& result) {
+	result.nodes.clear();
+	result.error = TemplateError::NONE;
+	result.errorPosition = 0;
+
+	auto fail = [&result](TemplateError error, size_t position) {
+		result.error = error;
+		result.errorPosition = position;
+	};
+	auto addText = [&result](size_t position, std::string_view text) {
+		TemplateNode node{ TemplateNode::Type::TEXT, position, text };
+		result.nodes.push_back(node);
+	};
+
+	// Positions of the open tags, to match closing tags and to report tags left open
+	struct OpenTag { std::string_view name; size_t position; };
+	std::vector<OpenTag> openTags;
+
+	size_t i = 0;
+	size_t textStart = 0;
+	auto flushText = [&]() {
+		if (i > textStart) addText(textStart, source.substr(textStart, i - textStart));
+	};
+
+	while (i < source.size()) {
+		char c = source[i];
+		if (c == ']') {
+			flushText();
+			if (i + 1 >= source.size() || source[i + 1] != ']') return fail(TemplateError::LONE_CLOSING_BRACKET, i);
+			addText(i, source.substr(i + 1, 1));
+			i += 2;
+			textStart = i;
+		}
+		else if (c == '%' && syntax == TemplateSyntax::TEMPLATE) {
+			flushText();
+			if (i + 1 >= source.size()) return fail(TemplateError::UNKNOWN_PARAMETER, i);
+			char parameter = source[i + 1];
+			if (parameter == '%') {
+				addText(i, source.substr(i + 1, 1));
+			}
+			else {
+				if (!isParameter(parameter, parameters)) return fail(TemplateError::UNKNOWN_PARAMETER, i);
+				TemplateNode node;
+				node.type = TemplateNode::Type::PARAMETER;
+				node.position = i;
+				node.parameter = parameter;
+				result.nodes.push_back(node);
+			}
+			i += 2;
+			textStart = i;
+		}
+		else if (c == '[') {
+			flushText();
+			size_t tagStart = i;
+			if (i + 1 >= source.size()) return fail(TemplateError::UNTERMINATED_TAG, tagStart);
+			if (source[i + 1] == '[') {
+				addText(i, source.substr(i + 1, 1));
+				i += 2;
+				textStart = i;
+				continue;
+			}
+			size_t tagEnd = source.find(']', i + 1);
+			if (tagEnd == std::string_view::npos) return fail(TemplateError::UNTERMINATED_TAG, tagStart);
+			std::string_view tag = source.substr(i + 1, tagEnd - i - 1);
+			i = tagEnd + 1;
+			textStart = i;
+
+			if (!tag.empty() && tag.front() == '/') {
+				std::string_view name = tag.substr(1);
+				if (name.empty() || openTags.empty() || openTags.back().name != name) return fail(TemplateError::UNEXPECTED_CLOSING_TAG, tagStart);
+				openTags.pop_back();
+				TemplateNode node;
+				node.type = name == "col" ? TemplateNode::Type::COLOR_END : TemplateNode::Type::ICON_END;
+				node.position = tagStart;
+				result.nodes.push_back(node);
+				continue;
+			}
+
+			size_t equals = tag.find('=');
+			std::string_view name = tag.substr(0, equals);
+			if (name != "col" && name != "icon") return fail(TemplateError::UNKNOWN_TAG, tagStart);
+			if (equals == std::string_view::npos) return fail(TemplateError::MISSING_TAG_VALUE, tagStart);
+			std::string_view value = tag.substr(equals + 1);
+
+			TemplateNode node{ TemplateNode::Type::COLOR_BEGIN, tagStart, value };
+			if (name == "col") {
+				bool parameterColor = syntax == TemplateSyntax::TEMPLATE && value.size() == 2 && value[0] == '%' && value[1] == 'c' && isParameter('c', parameters);
+				if (parameterColor) node.parameter = 'c';
+				else if (!parseColor(value, node.rgb)) return fail(TemplateError::INVALID_COLOR, tagStart);
+			}
+			else {
+				if (!isDigits(value)) return fail(TemplateError::INVALID_ICON, tagStart);
+				node.type = TemplateNode::Type::ICON_BEGIN;
+				auto parsed = std::from_chars(value.data(), value.data() + value.size(), node.iconId);
+				if (parsed.ec != std::errc()) node.iconId = 0;
+			}
+			openTags.push_back({ name, tagStart });
+			result.nodes.push_back(node);
+		}
+		else {
+			i++;
+		}
+	}
+	flushText();
+
+	if (!openTags.empty()) return fail(TemplateError::UNCLOSED_TAG, openTags.back().position);
+}
+
+GW2_SCT::TemplateParseResult GW2_SCT::TemplateParser::parse(std::string_view source, TemplateSyntax syntax, const std::map<char, std::string>* parameters) {
+	TemplateParseResult result;
+	parse(source, syntax, parameters, result);
+	return result;
+}
@@ -0,0 +1,25 @@
+#include "TemplateParser.h"
+#include <cstdio>
+#include "Common.h"
+#include "Language.h"
+
+// Kept apart from the parser, which is built without the addon's Windows and language headers in the tests
+std::string GW2_SCT::TemplateParser::describeError(const TemplateParseResult& result) {
+	LanguageKey key;
+	switch (result.error) {
+	case TemplateError::NONE: return "";
+	case TemplateError::LONE_CLOSING_BRACKET: key = LanguageKey::Template_Error_Lone_Closing_Bracket; break;
+	case TemplateError::UNTERMINATED_TAG: key = LanguageKey::Template_Error_Unterminated_Tag; break;
+	case TemplateError::UNKNOWN_TAG: key = LanguageKey::Template_Error_Unknown_Tag; break;
+	case TemplateError::MISSING_TAG_VALUE: key = LanguageKey::Template_Error_Missing_Tag_Value; break;
+	case TemplateError::INVALID_COLOR: key = LanguageKey::Template_Error_Invalid_Color; break;
+	case TemplateError::INVALID_ICON: key = LanguageKey::Template_Error_Invalid_Icon; break;
+	case TemplateError::UNEXPECTED_CLOSING_TAG: key = LanguageKey::Template_Error_Unexpected_Closing_Tag; break;
+	case TemplateError::UNCLOSED_TAG: key = LanguageKey::Template_Error_Unclosed_Tag; break;
+	case TemplateError::UNKNOWN_PARAMETER:
+	default: key = LanguageKey::Template_Error_Unknown_Parameter; break;
+	}
+	char buffer[512];
+	snprintf(buffer, sizeof(buffer), langString(LanguageCategory::Receiver_Option_UI, LanguageKey::Template_Error_At), (int)result.errorPosition + 1, langString(LanguageCategory::Receiver_Option_UI, key));
+	return std::string(buffer);
+}
@@ -31,6 +31,17 @@ void GW2_SCT::Texture::draw(ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEn
     }
 }
 
+ImTextureID GW2_SCT::Texture::prepareDraw() {
+    if (!_created && std::chrono::system_clock::now() > _nextCreationTry) {
+        requestCreation();
+    }
+
+    if (_created) {
+        return internalPrepareDraw();
+    }
+    return nullptr;
+}
+
 
 void GW2_SCT::Texture::ensureCreation() {
     if (!_created && std::chrono::system_clock::now() > _nextCreationTry) {
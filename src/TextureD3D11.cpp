@@ -128,6 +128,10 @@ void GW2_SCT::ImmutableTextureD3D11::internalDraw(ImVec2 pos, ImVec2 size, ImVec
     }
 }
 
+ImTextureID GW2_SCT::ImmutableTextureD3D11::internalPrepareDraw() {
+    return _texture11View;
+}
+
 bool GW2_SCT::ImmutableTextureD3D11::internalCreate() {
 #if _DEBUG
     LOG("ImmutableTextureD3D11: Calling create()");
@@ -144,6 +148,13 @@ GW2_SCT::MutableTextureD3D11::~MutableTextureD3D11() {
 }
 
 void GW2_SCT::MutableTextureD3D11::internalDraw(ImVec2 pos, ImVec2 size, ImVec2 uvStart, ImVec2 uvEnd, ImU32 color) {
+    ImTextureID textureId = internalPrepareDraw();
+    if (textureId != nullptr) {
+        ImGui::GetForegroundDrawList()->AddImage(textureId, pos, ImVec2(pos.x + size.x, pos.y + size.y), uvStart, uvEnd, color);
+    }
+}
+
+ImTextureID GW2_SCT::MutableTextureD3D11::internalPrepareDraw() {
     if (_stagingChanged && d3D11Context != nullptr && _texture11View != nullptr) {
         std::lock_guard<std::mutex> lock(_stagingMutex);
         if (_stagingChanged) {
@@ -151,9 +162,7 @@ void GW2_SCT::MutableTextureD3D11::internalDraw(ImVec2 pos, ImVec2 size, ImVec2
             _stagingChanged = false;
         }
     }
-    if (_texture11View != nullptr) {
-        ImGui::GetForegroundDrawList()->AddImage(_texture11View, pos, ImVec2(pos.x + size.x, pos.y + size.y), uvStart, uvEnd, color);
-    }
+    return _texture11View;
 }
 
 bool GW2_SCT::MutableTextureD3D11::internalCreate() {
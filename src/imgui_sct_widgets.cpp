@@ -12,6 +12,7 @@
 #include "Language.h"
 #include "Common.h"
 #include "TemplateInterpreter.h"
+#include "TemplateParser.h"
 #include "Options.h"
 
 constexpr const float& clampf(const float& v, const float& lo, const float& hi) {
@@ -88,6 +89,7 @@ int ImGui::ReceiverCollapsible(int index, std::shared_ptr<GW2_SCT::message_recei
 			int categoryIterator = 0;
 			for (auto& categoryAndNamePair : GW2_SCT::categoryNames) {
 				if (Selectable(BuildLabel(categoryAndNamePair.second, "receiver-category-combo", indexString + std::to_string(categoryIterator)).c_str(), receiverOptions->category == categoryAndNamePair.first)) {
+					if (receiverOptions->category != categoryAndNamePair.first) returnFlags |= ReceiverCollapsible_Rerouted;
 					receiverOptions->category = categoryAndNamePair.first;
 				}
 				categoryIterator++;
@@ -98,6 +100,7 @@ int ImGui::ReceiverCollapsible(int index, std::shared_ptr<GW2_SCT::message_recei
 			int typeIterator = 0;
 			for (auto& typeAndNamePair : GW2_SCT::typeNames) {
 				if (Selectable(BuildLabel(typeAndNamePair.second, "receiver-type-combo", indexString + std::to_string(typeIterator)).c_str(), receiverOptions->type == typeAndNamePair.first)) {
+					if (receiverOptions->type != typeAndNamePair.first) returnFlags |= ReceiverCollapsible_Rerouted;
 					receiverOptions->type = typeAndNamePair.first;
 				}
 				typeIterator++;
@@ -110,13 +113,16 @@ int ImGui::ReceiverCollapsible(int index, std::shared_ptr<GW2_SCT::message_recei
 			struct UserData {
 				bool changedBG = false;
 				std::map<char, std::string> options;
+				std::string error;
 			} ud;
 			ud.options = GW2_SCT::receiverInformationPerCategoryAndType.at(receiverOptions->category).at(receiverOptions->type).options;
 			if (InputText(BuildLabel(langString(GW2_SCT::LanguageCategory::Receiver_Option_UI, GW2_SCT::LanguageKey::Template), "receiver-template-input", indexString).c_str(), &edit, ImGuiInputTextFlags_CallbackAlways, [](ImGuiInputTextCallbackData* data) {
 				UserData* d = static_cast<UserData*>(data->UserData);
-				if (!GW2_SCT::TemplateInterpreter::validate(std::string(data->Buf), d->options)) {
+				GW2_SCT::TemplateParseResult parsed = GW2_SCT::TemplateParser::parse(data->Buf, GW2_SCT::TemplateSyntax::TEMPLATE, &d->options);
+				if (!parsed.valid()) {
 					PushStyleColor(ImGuiCol_FrameBg, ImVec4(1.f, 0.f, 0.f, .6f));
 					d->changedBG = true;
+					d->error = GW2_SCT::TemplateParser::describeError(parsed);
 				}
 				return 0;
 				}, &ud)) {
@@ -137,6 +143,9 @@ int ImGui::ReceiverCollapsible(int index, std::shared_ptr<GW2_SCT::message_recei
 			if (ud.changedBG) {
 				PopStyleColor();
 			}
+			if (!ud.error.empty()) {
+				TextColored(ImVec4(1.f, .4f, .4f, 1.f), "%s", ud.error.c_str());
+			}
 
 			Combo(langStringG(GW2_SCT::LanguageKey::Font), &receiverOptions->font, GW2_SCT::Options::getFontSelectionString().c_str());
 			int selected = 2;
@@ -198,6 +207,7 @@ int ImGui::ReceiverCollapsible(int index, std::shared_ptr<GW2_SCT::message_recei
 				ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.67f, 0.40f, 0.40f, 0.60f));
 				if (ImGui::SmallButton("Remove")) {
 					it = receiverOptions->assignedFilterSets.erase(it);
+					GW2_SCT::Options::get()->filterManager.markChanged();
 					GW2_SCT::Options::requestSave();
 				}
 				else {
@@ -254,6 +264,7 @@ int ImGui::ReceiverCollapsible(int index, std::shared_ptr<GW2_SCT::message_recei
 			SameLine();
 			if (Button(BuildLabel("Add", "receiver-add-filter-button", indexString).c_str())) {
 				receiverOptions->assignedFilterSets.push_back(availableFilterSets[selectedIndex]);
+				GW2_SCT::Options::get()->filterManager.markChanged();
 				GW2_SCT::Options::requestSave();
 
 				selectedIndex = 0;
@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <deque>
+#include <random>
+#include "CombineQueue.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	struct KeyHash {
+		size_t operator()(uint32_t key) const { return key * 0x9E3779B1u; }
+	};
+	using Queue = CombineQueue<uint64_t, uint32_t, KeyHash>;
+
+	struct ReferenceEntry {
+		uint32_t key;
+		uint64_t value;
+	};
+
+	// What ScrollArea did before the index: the combine target is the newest queued message with the key
+	const ReferenceEntry* referenceNewest(const std::deque<ReferenceEntry>& reference, uint32_t key) {
+		for (auto it = reference.rbegin(); it != reference.rend(); ++it) {
+			if (it->key == key) return &*it;
+		}
+		return nullptr;
+	}
+
+	void checkSame(Queue& queue, const std::deque<ReferenceEntry>& reference, uint32_t keyCount) {
+		SCT_CHECK(queue.size() == reference.size());
+		for (uint32_t key = 0; key < keyCount; key++) {
+			const ReferenceEntry* expected = referenceNewest(reference, key);
+			Queue::iterator found = queue.findNewest(key);
+			if (expected == nullptr) {
+				SCT_CHECK_MESSAGE(found == queue.end(), "key %u should not be indexed", key);
+			}
+			else {
+				SCT_CHECK_MESSAGE(found != queue.end() && found->value == expected->value, "key %u should find %llu", key, (unsigned long long)expected->value);
+			}
+		}
+	}
+
+	// Random pushes and removals from the front, the back and the middle, like painting, threshold drops
+	// of combined messages and the overload modes do
+	void testMatchesBackwardWalk() {
+		const uint32_t keyCount = 6;
+		std::mt19937 rng(0xC0B1u);
+		Queue queue;
+		std::deque<ReferenceEntry> reference;
+		uint64_t nextValue = 0;
+		for (int round = 0; round < 200000; round++) {
+			uint32_t op = rng() % 10;
+			if (op < 5 || reference.empty()) {
+				uint32_t key = rng() % keyCount;
+				queue.push(key, nextValue);
+				reference.push_back({ key, nextValue });
+				nextValue++;
+			}
+			else if (op == 5) {
+				queue.popFront();
+				reference.pop_front();
+			}
+			else if (op == 6) {
+				queue.popBack();
+				reference.pop_back();
+			}
+			else if (op == 7) {
+				// Combined message dropped for its thresholds
+				uint32_t key = rng() % keyCount;
+				Queue::iterator newest = queue.findNewest(key);
+				if (newest == queue.end()) continue;
+				for (auto it = reference.end(); it != reference.begin();) {
+					--it;
+					if (it->key == key) {
+						reference.erase(it);
+						break;
+					}
+				}
+				queue.erase(newest);
+			}
+			else {
+				size_t at = rng() % reference.size();
+				queue.erase(queue.begin() + at);
+				reference.erase(reference.begin() + at);
+			}
+			if (round % 16 == 0 || reference.size() < 4) checkSame(queue, reference, keyCount);
+		}
+		checkSame(queue, reference, keyCount);
+	}
+
+	void testOlderMessageTakesOver() {
+		Queue queue;
+		queue.push(1, 10);
+		queue.push(2, 20);
+		queue.push(1, 11);
+		queue.push(1, 12);
+		queue.erase(queue.findNewest(1));
+		SCT_CHECK(queue.findNewest(1)->value == 11);
+		queue.erase(queue.begin() + 1); // 20
+		queue.erase(queue.findNewest(1));
+		SCT_CHECK(queue.findNewest(1)->value == 10);
+		SCT_CHECK(queue.findNewest(2) == queue.end());
+		queue.popFront();
+		SCT_CHECK(queue.empty() && queue.findNewest(1) == queue.end());
+	}
+}
+
+int main() {
+	testOlderMessageTakesOver();
+	testMatchesBackwardWalk();
+	return 0;
+}
@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "EventClassifier.h"
+#include "EventClassifierReference.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+int main() {
+	// Roughly the mix of a fight: mostly direct hits, some condition ticks, heals and barrier
+	std::mt19937 rng(7);
+	std::vector<cbtevent1> events(1 << 16);
+	const uint32_t skillIds[] = { 5491, 736, 737, 723, 861, 19426, 1 };
+	for (cbtevent1& ev : events) {
+		ev = {};
+		uint32_t kind = rng() % 10;
+		ev.buff = kind >= 6;
+		ev.skillid = skillIds[rng() % 7];
+		ev.result = (uint8_t)(rng() % (CBTR_DOWNED + 1));
+		if (kind < 5) ev.value = -(int32_t)(rng() % 20000);
+		else if (kind == 5) ev.value = rng() % 5000;
+		else if (kind < 9) ev.buff_dmg = -(int32_t)(rng() % 3000);
+		else ev.buff_dmg = rng() % 1000;
+		if (rng() % 8 == 0) ev.overstack_value = rng() % 2000;
+	}
+	const size_t iterations = 5000000;
+	size_t mask = events.size() - 1;
+	size_t sink = 0;
+
+	double ladder = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+		Tests::ReferenceClassification classified = Tests::ReferenceClassifyEvent(events[i & mask]);
+		sink += classified.types.size() + (size_t)classified.value;
+	});
+	double table = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+		ClassifiedEvent classified = classifyCombatEvent(events[i & mask]);
+		sink += classified.typeCount + (size_t)classified.value;
+	});
+	std::printf("if-ladder with std::vector %6.1f ns, classifyCombatEvent %6.1f ns per event\n", ladder, table);
+	std::printf("(%zu)\n", sink);
+	return 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include "CombatTypes.h"
+
+namespace GW2_SCT::Tests {
+	struct ReferenceClassification {
+		std::vector<MessageType> types;
+		int32_t value;
+		int32_t buffValue;
+	};
+
+	// The if-ladder CombatEventLocal used before classifyCombatEvent, working on a copy of the event
+	inline ReferenceClassification ReferenceClassifyEvent(cbtevent1 event) {
+		cbtevent1* ev1 = &event;
+		std::vector<MessageType> types;
+
+		if (ev1->buff) {
+			// Buff-based effects (DoT, HoT, etc.)
+			if (ev1->buff_dmg > 0) {
+				if (ev1->overstack_value != 0) {
+					ev1->buff_dmg -= ev1->overstack_value;
+					types.push_back(MessageType::SHIELD_RECEIVE);
+				}
+				if (ev1->buff_dmg > 0) {
+					types.push_back(MessageType::HOT);
+				}
+			}
+			else if (ev1->buff_dmg < 0) {
+				if (ev1->overstack_value > 0) {
+					ev1->buff_dmg += ev1->overstack_value;
+					types.push_back(MessageType::SHIELD_REMOVE);
+				}
+				if (ev1->buff_dmg < 0) {
+					switch (ev1->skillid) {
+					case 736: types.push_back(MessageType::BLEEDING); break;
+					case 737: types.push_back(MessageType::BURNING); break;
+					case 723: types.push_back(MessageType::POISON); break;
+					case 861: types.push_back(MessageType::CONFUSION); break;
+					case 19426: types.push_back(MessageType::TORMENT); break;
+					default: types.push_back(MessageType::DOT); break;
+					}
+				}
+			}
+		}
+		else {
+			// Non-buff effects (direct damage, healing, barriers)
+			if (ev1->value > 0) {
+				if (ev1->overstack_value != 0) {
+					types.push_back(MessageType::SHIELD_RECEIVE);
+				}
+				else {
+					types.push_back(MessageType::HEAL);
+				}
+			}
+			else {
+				if (ev1->overstack_value > 0) {
+					ev1->value += ev1->overstack_value;
+					types.push_back(MessageType::SHIELD_REMOVE);
+				}
+				if (ev1->overstack_value <= 0 || ev1->value < 0) {
+					switch (ev1->result) {
+					case CBTR_GLANCE:
+					case CBTR_INTERRUPT:
+					case CBTR_NORMAL: types.push_back(MessageType::PHYSICAL); break;
+					case CBTR_CRIT: types.push_back(MessageType::CRIT); break;
+					case CBTR_BLOCK: types.push_back(MessageType::BLOCK);  break;
+					case CBTR_EVADE: types.push_back(MessageType::EVADE); break;
+					case CBTR_ABSORB: types.push_back(MessageType::INVULNERABLE); break;
+					case CBTR_BLIND: types.push_back(MessageType::MISS); break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+		return { types, ev1->value, ev1->buff_dmg };
+	}
+}
@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <random>
+#include "EventClassifier.h"
+#include "EventClassifierReference.h"
+#include "EventRecord.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+// Most cases are checked at compile time, the classifier is constexpr
+namespace {
+	constexpr cbtevent1 makeEvent(uint8_t buff, int32_t value, int32_t buffDmg, uint32_t overstack, uint8_t result = CBTR_NORMAL, uint32_t skillId = 1) {
+		cbtevent1 ev = {};
+		ev.buff = buff;
+		ev.value = value;
+		ev.buff_dmg = buffDmg;
+		ev.overstack_value = overstack;
+		ev.result = result;
+		ev.skillid = skillId;
+		return ev;
+	}
+	constexpr bool is(const ClassifiedEvent& c, MessageType first = MessageType::NONE, MessageType second = MessageType::NONE) {
+		uint8_t expectedCount = (first != MessageType::NONE) + (second != MessageType::NONE);
+		return c.typeCount == expectedCount
+			&& (expectedCount < 1 || c.types[0] == first)
+			&& (expectedCount < 2 || c.types[1] == second);
+	}
+
+	// Direct hits
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 0, CBTR_NORMAL)), MessageType::PHYSICAL));
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 0, CBTR_GLANCE)), MessageType::PHYSICAL));
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 0, CBTR_INTERRUPT)), MessageType::PHYSICAL));
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 0, CBTR_CRIT)), MessageType::CRIT));
+	static_assert(is(classifyCombatEvent(makeEvent(0, 0, 0, 0, CBTR_BLOCK)), MessageType::BLOCK));
+	static_assert(is(classifyCombatEvent(makeEvent(0, 0, 0, 0, CBTR_EVADE)), MessageType::EVADE));
+	static_assert(is(classifyCombatEvent(makeEvent(0, 0, 0, 0, CBTR_ABSORB)), MessageType::INVULNERABLE));
+	static_assert(is(classifyCombatEvent(makeEvent(0, 0, 0, 0, CBTR_BLIND)), MessageType::MISS));
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 0, CBTR_KILLINGBLOW))));
+	// Barrier absorbing part or all of a hit
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 40, CBTR_CRIT)), MessageType::SHIELD_REMOVE, MessageType::CRIT));
+	static_assert(classifyCombatEvent(makeEvent(0, -100, 0, 40, CBTR_CRIT)).value == -60);
+	static_assert(is(classifyCombatEvent(makeEvent(0, -100, 0, 100, CBTR_NORMAL)), MessageType::SHIELD_REMOVE));
+	// Heals and barrier gains
+	static_assert(is(classifyCombatEvent(makeEvent(0, 100, 0, 0)), MessageType::HEAL));
+	static_assert(is(classifyCombatEvent(makeEvent(0, 100, 0, 100)), MessageType::SHIELD_RECEIVE));
+	// Buff ticks
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, 50, 0)), MessageType::HOT));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, 50, 20)), MessageType::SHIELD_RECEIVE, MessageType::HOT));
+	static_assert(classifyCombatEvent(makeEvent(1, 0, 50, 20)).buffValue == 30);
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, 50, 50)), MessageType::SHIELD_RECEIVE));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 0, CBTR_NORMAL, 736)), MessageType::BLEEDING));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 0, CBTR_NORMAL, 737)), MessageType::BURNING));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 0, CBTR_NORMAL, 723)), MessageType::POISON));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 0, CBTR_NORMAL, 861)), MessageType::CONFUSION));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 0, CBTR_NORMAL, 19426)), MessageType::TORMENT));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 0, CBTR_NORMAL, 1)), MessageType::DOT));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 20, CBTR_NORMAL, 736)), MessageType::SHIELD_REMOVE, MessageType::BLEEDING));
+	static_assert(is(classifyCombatEvent(makeEvent(1, 0, -50, 50, CBTR_NORMAL, 736)), MessageType::SHIELD_REMOVE));
+	// Buff applications carry no damage
+	static_assert(is(classifyCombatEvent(makeEvent(1, 500, 0, 0))));
+}
+
+namespace {
+	int32_t pick(std::mt19937& rng, std::initializer_list<int32_t> edges) {
+		if (rng() % 4 == 0) return edges.begin()[rng() % edges.size()];
+		return (int32_t)rng() >> (rng() % 32);
+	}
+
+	void testRandomEventsMatchTheOldLadder() {
+		std::mt19937 rng(0xC1A55u);
+		const uint32_t skillIds[] = { 1, 723, 736, 737, 861, 19426, 5491 };
+		for (int i = 0; i < 2000000; i++) {
+			cbtevent1 ev = {};
+			ev.buff = rng() % 2;
+			ev.value = pick(rng, { 0, 1, -1, INT32_MIN, INT32_MAX });
+			ev.buff_dmg = pick(rng, { 0, 1, -1, INT32_MIN, INT32_MAX });
+			ev.overstack_value = rng() % 2 ? 0 : (uint32_t)pick(rng, { 1, -1, INT32_MIN, INT32_MAX });
+			ev.result = (uint8_t)(rng() % 3 == 0 ? rng() : rng() % (CBTR_DOWNED + 1));
+			ev.skillid = skillIds[rng() % std::size(skillIds)];
+
+			ClassifiedEvent classified = classifyCombatEvent(ev);
+			Tests::ReferenceClassification reference = Tests::ReferenceClassifyEvent(ev);
+			SCT_CHECK_MESSAGE(classified.typeCount == reference.types.size(), "buff %u value %d buff_dmg %d overstack %u result %u: %u types, expected %zu",
+				ev.buff, ev.value, ev.buff_dmg, ev.overstack_value, ev.result, classified.typeCount, reference.types.size());
+			for (size_t t = 0; t < reference.types.size(); t++) {
+				SCT_CHECK(classified.types[t] == reference.types[t]);
+			}
+			// The values only matter when a message is created
+			if (classified.typeCount > 0) {
+				SCT_CHECK(classified.value == reference.value);
+				SCT_CHECK(classified.buffValue == reference.buffValue);
+			}
+		}
+	}
+}
+
+namespace {
+	const char* unknownName(UnknownName name) {
+		return name == UnknownName::SKILL ? "<Skill>" : "<Area>";
+	}
+
+	bool hasCategories(const EventRecord& record, std::initializer_list<MessageCategory> categories) {
+		if (record.categoryCount != categories.size()) return false;
+		for (size_t i = 0; i < categories.size(); i++) {
+			if (record.categories[i] != categories.begin()[i]) return false;
+		}
+		return true;
+	}
+
+	// The categories CombatEventLocal delivers an event in, from the player's and their pets' point of view
+	void testCategorySelection() {
+		ag player = { "Player", 1, PROFESSION_RANGER, 0, 1, 0 };
+		ag golem = { nullptr, 2, 0, 0, 0, 0 };
+		ag pet = { "Pet", 3, 0, 0, 0, 0 };
+		EventIngestState state;
+		CombatHotOptions options;
+		EventRecord record;
+
+		cbtevent1 hit = makeEvent(0, -100, 0, 0);
+		hit.src_instid = 7;
+		SCT_CHECK(buildEventRecord(state, options, hit, player, golem, "Shot", unknownName, record));
+		SCT_CHECK(state.selfInstId == 7);
+		SCT_CHECK(hasCategories(record, { MessageCategory::PLAYER_OUT }));
+		SCT_CHECK(record.value == -100 && record.src.id == 1 && record.dst.id == 2);
+		SCT_CHECK(StringInterner::view(record.dst.name) == "<Area>" && StringInterner::view(record.skillName) == "Shot");
+
+		cbtevent1 petHit = makeEvent(0, -50, 0, 0);
+		petHit.src_master_instid = 7;
+		SCT_CHECK(buildEventRecord(state, options, petHit, pet, golem, nullptr, unknownName, record));
+		SCT_CHECK(hasCategories(record, { MessageCategory::PET_OUT }));
+		SCT_CHECK(StringInterner::view(record.skillName) == "<Skill>");
+
+		cbtevent1 petHurt = makeEvent(0, -50, 0, 0);
+		petHurt.dst_master_instid = 7;
+		SCT_CHECK(buildEventRecord(state, options, petHurt, golem, pet, "Slam", unknownName, record));
+		SCT_CHECK(hasCategories(record, { MessageCategory::PET_IN }));
+
+		cbtevent1 selfHeal = makeEvent(0, 100, 0, 0);
+		SCT_CHECK(buildEventRecord(state, options, selfHeal, player, player, "Heal", unknownName, record));
+		SCT_CHECK(hasCategories(record, { MessageCategory::PLAYER_OUT, MessageCategory::PLAYER_IN }));
+		options.selfMessageOnlyIncoming = true;
+		SCT_CHECK(buildEventRecord(state, options, selfHeal, player, player, "Heal", unknownName, record));
+		SCT_CHECK(hasCategories(record, { MessageCategory::PLAYER_IN }));
+
+		options.outgoingOnlyToTarget = true;
+		SCT_CHECK(!buildEventRecord(state, options, hit, player, golem, "Shot", unknownName, record));
+		state.targetAgentId = golem.id;
+		SCT_CHECK(buildEventRecord(state, options, hit, player, golem, "Shot", unknownName, record));
+
+		cbtevent1 bystander = makeEvent(0, -100, 0, 0);
+		SCT_CHECK(!buildEventRecord(state, options, bystander, golem, pet, "Shot", unknownName, record));
+		cbtevent1 activation = hit;
+		activation.is_activation = 1;
+		SCT_CHECK(!buildEventRecord(state, options, activation, player, golem, "Shot", unknownName, record));
+	}
+}
+
+int main() {
+	testCategorySelection();
+	testRandomEventsMatchTheOldLadder();
+	return 0;
+}
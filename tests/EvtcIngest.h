@@ -0,0 +1,292 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "CombineQueue.h"
+#include "EventRecord.h"
+#include "EvtcLog.h"
+#include "Message.h"
+#include "MpscRingBuffer.h"
+#include "StringInterner.h"
+#include "TemplateParser.h"
+
+namespace GW2_SCT::Tests {
+	// Writes an uncompressed revision 1 log: "EVTC", build date, revision, boss species and padding, then the tables in the layout EvtcLog::parse reads
+	class EvtcLogWriter {
+	public:
+		EvtcLogWriter() : bytes(std::begin(header), std::end(header)) {}
+		void agents(const std::vector<EvtcLog::Agent>& agents) {
+			write<uint32_t>((uint32_t)agents.size());
+			for (const EvtcLog::Agent& agent : agents) {
+				write(agent.addr);
+				write(agent.prof);
+				write(agent.elite);
+				bytes.resize(bytes.size() + 6 * sizeof(int16_t));
+				name(agent.name);
+				bytes.resize(bytes.size() + 4);
+			}
+		}
+		void skills(const std::vector<std::pair<uint32_t, std::string>>& skills) {
+			write<uint32_t>((uint32_t)skills.size());
+			for (const auto& [id, skillName] : skills) {
+				write<int32_t>((int32_t)id);
+				name(skillName);
+			}
+		}
+		void event(const cbtevent1& ev) { write(ev); }
+		std::vector<char> bytes;
+	private:
+		static constexpr char header[] = { 'E', 'V', 'T', 'C', '2', '0', '2', '4', '0', '1', '0', '1', 1, 0, 0, 0 };
+
+		template <class T>
+		void write(const T& value) {
+			const char* raw = reinterpret_cast<const char*>(&value);
+			bytes.insert(bytes.end(), raw, raw + sizeof(T));
+		}
+		void name(const std::string& text) {
+			char field[64] = {};
+			std::memcpy(field, text.data(), std::min(text.size(), sizeof(field)));
+			bytes.insert(bytes.end(), field, field + sizeof(field));
+		}
+	};
+
+	// A fight of the log's point of view player against a few targets: direct hits, crits,
+	// condition ticks, heals, barrier, skill activations and state changes
+	inline std::vector<char> makeSyntheticLog(size_t eventCount) {
+		const uint64_t pov = 1000;
+		std::vector<EvtcLog::Agent> agents = { { pov, PROFESSION_ELEMENTALIST, 0, "Weaver" } };
+		for (uint64_t i = 1; i <= 24; i++) agents.push_back({ pov + i, 0, 0, i % 8 == 0 ? "" : "Target " + std::to_string(i) });
+		std::vector<std::pair<uint32_t, std::string>> skills = { { 736, "Bleeding" }, { 737, "Burning" }, { 723, "Poison" } };
+		for (uint32_t i = 0; i < 60; i++) skills.push_back({ 5000 + i, "Skill " + std::to_string(i) });
+
+		EvtcLogWriter writer;
+		writer.agents(agents);
+		writer.skills(skills);
+		cbtevent1 pointOfView = {};
+		pointOfView.src_agent = pov;
+		pointOfView.is_statechange = 13;
+		writer.event(pointOfView);
+
+		uint32_t seed = 12345;
+		auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+		for (size_t i = 0; i < eventCount; i++) {
+			cbtevent1 ev = {};
+			ev.time = 1000 + i;
+			uint64_t target = pov + 1 + next() % 24;
+			bool incoming = next() % 4 == 0;
+			ev.src_agent = incoming ? target : pov;
+			ev.dst_agent = incoming ? pov : target;
+			// Instance ids as in game, where none is 0, so that no hit is mistaken for one of the player's pets
+			ev.src_instid = static_cast<uint16_t>(ev.src_agent - pov + 1);
+			ev.dst_instid = static_cast<uint16_t>(ev.dst_agent - pov + 1);
+			ev.skillid = 5000 + next() % 64; // a few ids without a name
+			uint32_t kind = next() % 16;
+			if (kind < 8) {
+				ev.value = -(int32_t)(next() % 8000);
+				ev.result = kind < 2 ? CBTR_CRIT : CBTR_NORMAL;
+			}
+			else if (kind < 11) {
+				ev.buff = 1;
+				ev.skillid = 736 + next() % 2;
+				ev.buff_dmg = -(int32_t)(next() % 900);
+			}
+			else if (kind < 12) {
+				ev.value = next() % 3000;
+				if (next() % 3 == 0) ev.overstack_value = next() % 1000;
+			}
+			else if (kind < 14) {
+				ev.is_activation = 1;
+			}
+			else if (kind < 15) {
+				ev.is_statechange = 4;
+			}
+			else {
+				ev.buff = 1; // application, no damage
+			}
+			writer.event(ev);
+		}
+		return writer.bytes;
+	}
+
+	// Time and allocations one stage of EvtcPipeline::replay spent over a whole log
+	struct EvtcStageCost {
+		double nanos = 0;
+		size_t allocations = 0;
+	};
+
+	// The way of a combat event from the arcdps callback to a message ready for layout, run over a log
+	// with the addon's own code. The log's point of view agent is the player, skills are not remapped.
+	//   ingest:  buildEventRecord and the push into the ingest ring, the combat thread's part
+	//   route:   draining the ring into one payload per perspective and one message per category and
+	//            type, like SCTMain::routeEvent
+	//   combine: the combine index and EventMessage::tryToCombineWith, like ScrollArea::receiveMessage
+	//            with one receiver per category and type and no filters or thresholds
+	//   render:  EventMessage::render of every new or combined message with its compiled template
+	//   parse:   TemplateParser over the rendered markup, the part of TemplateInterpreter::interpret
+	//            that does not need a font
+	// Glyph layout and quads need the font atlas and a D3D device and are not covered. Every frameEvents
+	// events one frame is run: the ring is drained and the queue is cut to queueDepth messages, as
+	// painting them would.
+	class EvtcPipeline {
+	public:
+		enum Stage { INGEST, ROUTE, COMBINE, RENDER, PARSE, STAGE_COUNT };
+		static constexpr const char* stageNames[STAGE_COUNT] = { "ingest", "route", "combine", "render", "parse" };
+
+		struct Result {
+			size_t records = 0;  // events queued into the ring
+			size_t messages = 0; // deliveries to a category and type
+			size_t combined = 0; // deliveries combined into a queued message
+			size_t parsedNodes = 0;
+			std::array<EvtcStageCost, STAGE_COUNT> stages = {};
+		};
+
+		// allocationCount returns the number of allocations made so far, without it none are reported
+		explicit EvtcPipeline(const EvtcLog& evtc, size_t (*allocationCount)() = nullptr) : evtc(evtc), allocationCount(allocationCount) {
+			agents.reserve(evtc.agents.size());
+			for (const EvtcLog::Agent& agent : evtc.agents) {
+				agents.push_back({ agent.name.c_str(), static_cast<uintptr_t>(agent.addr), agent.prof, agent.elite, agent.addr == evtc.povAddr ? 1u : 0u, 0 });
+			}
+			for (size_t c = 0; c < NUM_CATEGORIES; c++) {
+				MessageCategory category = static_cast<MessageCategory>(c);
+				const char* outputTemplate = isIncomingCategory(category) ? "%i ([col=%c]%n[/col]) -[col=FFFFFF]%v[/col]" : "%i [col=FFFFFF]%v[/col] %s";
+				for (size_t t = 0; t < NUM_MESSAGE_TYPES; t++) {
+					templates[c][t] = CompiledTemplate::compile(outputTemplate, "FFFFFF", category, static_cast<MessageType>(t));
+				}
+			}
+			renderOptions.showCombinedHitCount = true;
+			renderOptions.text = [](MessageText text) { return text == MessageText::MULTIPLE_SOURCES ? "Multiple Sources" : "hits"; };
+			renderOptions.professionName = [](uint32_t) { return "Elementalist"; };
+			renderOptions.professionColor = [](uint32_t) { return "F68A87"; };
+		}
+
+		Result replay(size_t frameEvents = 256, size_t queueDepth = 30) {
+			Result result;
+			routed.reserve(frameEvents * EventRecord::maxCategories * EventRecord::maxTypes);
+			touched.reserve(routed.capacity());
+			EventIngestState state;
+			auto next = evtc.events.begin();
+			while (next != evtc.events.end()) {
+				auto frameEnd = next + std::min<size_t>(frameEvents, evtc.events.end() - next);
+				measure(result.stages[INGEST], [&]() {
+					for (; next != frameEnd; ++next) {
+						const cbtevent1& ev = *next;
+						auto skill = evtc.skillNames.find(ev.skillid);
+						const char* skillName = skill != evtc.skillNames.end() ? skill->second.c_str() : nullptr;
+						EventRecord record;
+						if (!buildEventRecord(state, CombatHotOptions(), ev, agentOf(ev.src_agent), agentOf(ev.dst_agent), skillName, unknownName, record)) continue;
+						ring.push(record);
+						result.records++;
+					}
+				});
+				measure(result.stages[ROUTE], [&]() { route(); });
+				measure(result.stages[COMBINE], [&]() { combine(result); });
+				measure(result.stages[RENDER], [&]() {
+					for (QueuedMessage* message : touched) message->message->render(*message->compiled, renderOptions, message->text);
+				});
+				measure(result.stages[PARSE], [&]() {
+					for (QueuedMessage* message : touched) {
+						TemplateParser::parse(message->text, TemplateSyntax::RENDERED, nullptr, parsed);
+						result.parsedNodes += parsed.nodes.size();
+					}
+				});
+				result.messages += routed.size();
+				while (queue.size() > queueDepth) queue.popFront();
+			}
+			return result;
+		}
+
+	private:
+		struct QueuedMessage {
+			std::shared_ptr<EventMessage> message;
+			const CompiledTemplate* compiled = nullptr;
+			std::string text;
+		};
+		struct CombineKey {
+			uint32_t route = 0; // category and type, stands in for the receiver
+			uint32_t skillId = 0;
+			uint64_t entityId = 0;
+			bool operator==(const CombineKey& other) const = default;
+		};
+		struct CombineKeyHash {
+			size_t operator()(const CombineKey& key) const {
+				uint64_t h = (uint64_t(key.route) << 32 | key.skillId) * 0x9E3779B97F4A7C15ull;
+				h ^= key.entityId + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+				return static_cast<size_t>(h);
+			}
+		};
+
+		static const char* unknownName(UnknownName name) {
+			return name == UnknownName::SKILL ? "Unknown Skill" : "Unknown";
+		}
+
+		const ag& agentOf(uint64_t addr) const {
+			auto found = evtc.agentIndex.find(addr);
+			return found != evtc.agentIndex.end() ? agents[found->second] : unknownAgent;
+		}
+
+		template <class F>
+		void measure(EvtcStageCost& cost, F&& fn) {
+			size_t allocationsBefore = allocationCount != nullptr ? allocationCount() : 0;
+			auto start = std::chrono::steady_clock::now();
+			fn();
+			cost.nanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			if (allocationCount != nullptr) cost.allocations += allocationCount() - allocationsBefore;
+		}
+
+		void route() {
+			routed.clear();
+			while (std::optional<EventRecord> record = ring.pop()) {
+				std::shared_ptr<const MessageData> outgoingPayload, incomingPayload;
+				for (size_t c = 0; c < record->categoryCount; c++) {
+					MessageCategory category = record->categories[c];
+					std::shared_ptr<const MessageData>& shared = isIncomingCategory(category) ? incomingPayload : outgoingPayload;
+					if (!shared) shared = std::make_shared<const MessageData>(*record, category);
+					for (size_t t = 0; t < record->typeCount; t++) {
+						routed.push_back({ category, record->types[t], shared, record->timepoint });
+					}
+				}
+			}
+		}
+
+		void combine(Result& result) {
+			touched.clear();
+			for (const RoutedMessage& message : routed) {
+				CombineKey key;
+				key.route = static_cast<uint32_t>(message.category) * NUM_MESSAGE_TYPES + static_cast<uint32_t>(message.type);
+				key.skillId = message.payload->skillId;
+				if (isIncomingCategory(message.category)) key.entityId = message.payload->entityId;
+
+				auto newest = queue.findNewest(key);
+				if (newest != queue.end() && newest->value.message->tryToCombineWith(message.category, message.type, message.payload)) {
+					touched.push_back(&newest->value);
+					result.combined++;
+					continue;
+				}
+				QueuedMessage queued;
+				queued.message = std::make_shared<EventMessage>(message.category, message.type, message.payload, message.timepoint);
+				queued.compiled = templates[static_cast<size_t>(message.category)][static_cast<size_t>(message.type)].get();
+				queue.push(key, std::move(queued));
+				// Queued entries keep their address until the frame ends, pushing to a deque does not move them
+				touched.push_back(&queue.back().value);
+			}
+		}
+
+		const EvtcLog& evtc;
+		size_t (*allocationCount)();
+		std::vector<ag> agents;
+		ag unknownAgent = { nullptr, 0, 0, 0, 0, 0 };
+		MpscRingBuffer<EventRecord, 8192> ring{ RingOverflowPolicy::DROP_OLDEST };
+		std::array<std::array<std::shared_ptr<const CompiledTemplate>, NUM_MESSAGE_TYPES>, NUM_CATEGORIES> templates;
+		MessageRenderOptions renderOptions;
+		std::vector<RoutedMessage> routed;
+		CombineQueue<QueuedMessage, CombineKey, CombineKeyHash> queue;
+		std::vector<QueuedMessage*> touched;
+		TemplateParseResult parsed;
+	};
+}
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
+#include "EvtcIngest.h"
+#include "EvtcLog.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	std::atomic<size_t> allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+// Usage: evtc-ingest-benchmark [log.evtc]
+// Without a path a synthetic fight is used. Reports the cost of parsing and, per stage of the way
+// from the combat callback to a rendered message, the time and allocations per event of the first
+// and of a repeated pass over the log, see EvtcPipeline.
+int main(int argc, char** argv) {
+	std::vector<char> data;
+	std::string source = "synthetic log";
+	if (argc > 1) {
+		std::ifstream file(argv[1], std::ios::binary);
+		if (!file.good()) {
+			std::fprintf(stderr, "Could not open %s.\n", argv[1]);
+			return 1;
+		}
+		data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		source = argv[1];
+	}
+	else {
+		data = Tests::makeSyntheticLog(1000000);
+	}
+	StringInterner::reserve(8192, 256 * 1024);
+
+	std::string error;
+	size_t before = allocations.load();
+	std::shared_ptr<EvtcLog> evtc;
+	double parseNanos = Tests::nanosecondsPerIteration(1, [&](size_t) { evtc = EvtcLog::parse(data, error); });
+	if (evtc == nullptr) {
+		std::fprintf(stderr, "%s: %s\n", source.c_str(), error.c_str());
+		return 1;
+	}
+	size_t parseAllocations = allocations.load() - before;
+	size_t events = evtc->events.size();
+	std::printf("%s: %zu events, %zu agents, %zu skills\n", source.c_str(), events, evtc->agents.size(), evtc->skillNames.size());
+	std::printf("parse: %.1f ms, %zu allocations\n", parseNanos / 1e6, parseAllocations);
+
+	Tests::EvtcPipeline pipeline(*evtc, []() { return allocations.load(); });
+	for (const char* pass : { "first pass", "repeated pass" }) {
+		Tests::EvtcPipeline::Result result = pipeline.replay();
+		std::printf("%s: %zu records, %zu messages, %zu combined, %zu markup nodes\n", pass, result.records, result.messages, result.combined, result.parsedNodes);
+		Tests::EvtcStageCost total;
+		for (size_t stage = 0; stage < Tests::EvtcPipeline::STAGE_COUNT; stage++) {
+			const Tests::EvtcStageCost& cost = result.stages[stage];
+			total.nanos += cost.nanos;
+			total.allocations += cost.allocations;
+			std::printf("  %-8s %7.1f ns per event, %.4f allocations per event\n", Tests::EvtcPipeline::stageNames[stage], events != 0 ? cost.nanos / events : 0.0, events != 0 ? (double)cost.allocations / events : 0.0);
+		}
+		std::printf("  %-8s %7.1f ns per event, %.4f allocations per event\n", "total", events != 0 ? total.nanos / events : 0.0, events != 0 ? (double)total.allocations / events : 0.0);
+	}
+	return 0;
+}
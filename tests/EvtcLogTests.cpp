@@ -0,0 +1,114 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "EvtcIngest.h"
+#include "EvtcLog.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	std::atomic<size_t> allocations = 0;
+
+	struct AllocationCounter {
+		size_t start = allocations.load();
+		size_t count() const { return allocations.load() - start; }
+	};
+}
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	void testRoundTrip() {
+		Tests::EvtcLogWriter writer;
+		writer.agents({ { 7, PROFESSION_GUARDIAN, 62, "Firebrand" }, { 8, 0, 0, std::string(70, 'x') } });
+		writer.skills({ { 9143, "Mantra of Potence" } });
+		cbtevent1 pointOfView = {};
+		pointOfView.src_agent = 7;
+		pointOfView.is_statechange = 13;
+		writer.event(pointOfView);
+		cbtevent1 hit = {};
+		hit.time = 4242;
+		hit.src_agent = 7;
+		hit.dst_agent = 8;
+		hit.value = -1234;
+		hit.skillid = 9143;
+		writer.event(hit);
+
+		std::string error;
+		std::shared_ptr<EvtcLog> evtc = EvtcLog::parse(writer.bytes, error);
+		SCT_CHECK_MESSAGE(evtc != nullptr, "parse failed: %s", error.c_str());
+		SCT_CHECK(evtc->agents.size() == 2 && evtc->agentIndex.at(8) == 1);
+		SCT_CHECK(evtc->agents[0].prof == PROFESSION_GUARDIAN && evtc->agents[0].elite == 62 && evtc->agents[0].name == "Firebrand");
+		SCT_CHECK(evtc->agents[1].name == std::string(64, 'x'));
+		SCT_CHECK(evtc->skillNames.at(9143) == "Mantra of Potence");
+		SCT_CHECK(evtc->povAddr == 7);
+		SCT_CHECK(evtc->events.size() == 2);
+		SCT_CHECK(evtc->events[1].time == 4242 && evtc->events[1].value == -1234 && evtc->events[1].dst_agent == 8);
+	}
+
+	void testRejectedLogs() {
+		std::vector<char> log = Tests::makeSyntheticLog(10);
+		std::string error;
+
+		std::vector<char> compressed = { 'P', 'K', 3, 4 };
+		SCT_CHECK(EvtcLog::parse(compressed, error) == nullptr && error.find("Compressed") != std::string::npos);
+
+		std::vector<char> revision = log;
+		revision[12] = 0;
+		SCT_CHECK(EvtcLog::parse(revision, error) == nullptr && error == "Unsupported evtc revision 0.");
+
+		std::vector<char> truncated(log.begin(), log.begin() + 16 + 4 + 50);
+		SCT_CHECK(EvtcLog::parse(truncated, error) == nullptr && error == "Truncated agent table.");
+
+		std::vector<char> noSkills(log.begin(), log.begin() + 16 + 4 + 25 * 96);
+		SCT_CHECK(EvtcLog::parse(noSkills, error) == nullptr && error == "Truncated skill table.");
+
+		// A partially written last event is dropped
+		std::vector<char> partialEvent = log;
+		partialEvent.resize(partialEvent.size() - 10);
+		std::shared_ptr<EvtcLog> evtc = EvtcLog::parse(partialEvent, error);
+		SCT_CHECK(evtc != nullptr && evtc->events.size() == 10);
+	}
+
+	// After the first pass has interned every name, feeding events up to the ingest ring must not allocate
+	void testIngestDoesNotAllocate() {
+		StringInterner::reserve(8192, 256 * 1024);
+		std::string error;
+		std::shared_ptr<EvtcLog> evtc = EvtcLog::parse(Tests::makeSyntheticLog(100000), error);
+		SCT_CHECK_MESSAGE(evtc != nullptr, "parse failed: %s", error.c_str());
+		SCT_CHECK(evtc->povAddr == 1000);
+
+		Tests::EvtcPipeline pipeline(*evtc, []() { return allocations.load(); });
+		Tests::EvtcPipeline::Result first = pipeline.replay();
+		SCT_CHECK(first.records > evtc->events.size() / 2);
+		SCT_CHECK(first.messages >= first.records && first.combined > 0 && first.parsedNodes > 0);
+
+		Tests::EvtcPipeline::Result repeated = pipeline.replay();
+		SCT_CHECK(repeated.records == first.records && repeated.messages == first.messages);
+		size_t ingestAllocations = repeated.stages[Tests::EvtcPipeline::INGEST].allocations;
+		SCT_CHECK_MESSAGE(ingestAllocations == 0, "%zu allocations for %zu events", ingestAllocations, evtc->events.size());
+	}
+}
+
+int main() {
+	testRoundTrip();
+	testRejectedLogs();
+	testIngestDoesNotAllocate();
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include "Message.h"
+#include "OptionsStructures.h"
+#include "SkillFilterStructures.h"
+#include "StringInterner.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	// Single threaded test, a plain counter is enough
+	size_t allocations = 0;
+
+	struct AllocationCounter {
+		size_t start = allocations;
+		size_t count() const { return allocations - start; }
+	};
+}
+
+void* operator new(std::size_t size) {
+	allocations++;
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+	allocations++;
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	std::shared_ptr<const MessageData> makePayload(int32_t value) {
+		MessageData data;
+		data.skillId = 5491;
+		data.skillName = StringInterner::intern("Fireball");
+		data.entityName = StringInterner::intern("Training Golem");
+		data.entityId = 42;
+		data.value = value;
+		return std::make_shared<const MessageData>(data);
+	}
+
+	// What ScrollArea::paint and receiveMessage read of a queued message every frame or every hit
+	void testReadingAndCombiningDoesNotAllocate() {
+		auto payload = makePayload(-1234);
+		EventMessage message(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payload, std::chrono::system_clock::now());
+
+		SkillFilterManager filterManager;
+		auto filterSet = filterManager.createFilterSet("Blocked");
+		SkillFilter filter;
+		filter.skillId = 5491;
+		filterSet->filterSet.filters.push_back(filter);
+
+		message_receiver_options_struct receiver;
+		receiver.thresholdsEnabled = true;
+		receiver.damageThreshold = 100;
+		receiver.assignedFilterSets = { "Blocked" };
+		// Compiles the filter sets once, like the first message after an edit would
+		receiver.isThresholdExceeded(message, payload->skillId, payload->skillName, filterManager);
+
+		AllocationCounter counter;
+		int32_t checksum = 0;
+		for (int i = 0; i < 1000; i++) {
+			const MessageData* first = message.getFirstData();
+			SCT_CHECK(first == payload.get());
+			checksum += message.getAggregate().value + message.getCombinedValue() + (int32_t)message.getHitCount();
+			SCT_CHECK(message.tryToCombineWith(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payload));
+			SCT_CHECK(!message.tryToCombineWith(MessageCategory::PLAYER_IN, MessageType::PHYSICAL, payload));
+			receiver.isThresholdExceeded(message, first->skillId, first->skillName, filterManager);
+		}
+		SCT_CHECK_MESSAGE(counter.count() == 0, "%zu allocations while reading and combining", counter.count());
+		SCT_CHECK(message.getHitCount() == 1001);
+		SCT_CHECK(checksum != 0);
+	}
+
+	// A re-render after a combine writes into the string the prerender already owns
+	void testRenderingIntoAReusedStringDoesNotAllocate() {
+		auto payload = makePayload(-1234);
+		EventMessage message(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payload, std::chrono::system_clock::now());
+		auto receiver = std::make_shared<message_receiver_options_struct>();
+		receiver->outputTemplate = std::string("%v [col=FF0000]%s[/col] on %n (%d)");
+		receiver->transient_abbreviateSkillNames = true;
+		receiver->transient_numberShortPrecision = 1;
+
+		std::string out;
+		message.writeStringForOptions(receiver, out);
+		SCT_CHECK(!out.empty());
+		out.reserve(out.size() + 64);
+
+		AllocationCounter counter;
+		for (int i = 0; i < 1000; i++) {
+			message.tryToCombineWith(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payload);
+			message.writeStringForOptions(receiver, out);
+		}
+		SCT_CHECK_MESSAGE(counter.count() == 0, "%zu allocations while rendering", counter.count());
+		SCT_CHECK(out.find("1.2M") != std::string::npos);
+	}
+}
+
+int main() {
+	testReadingAndCombiningDoesNotAllocate();
+	testRenderingIntoAReusedStringDoesNotAllocate();
+	return 0;
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Message.h"
+#include "OptionsStructures.h"
+#include "StringInterner.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	// The shape of the handlers before the [category][type] table: nested maps of std::function,
+	// looked up for every combine attempt and for every placeholder of a template
+	struct MapHandler {
+		std::vector<std::function<bool(const MessageData&, const MessageData&)>> combineFunctions;
+		std::map<char, std::function<std::string(const MessageAggregate&)>> parameterFunctions;
+	};
+	using MapHandlers = std::map<MessageCategory, std::map<MessageType, MapHandler>>;
+
+	MapHandlers makeMapHandlers() {
+		MapHandler handler;
+		handler.combineFunctions.push_back([](const MessageData& a, const MessageData& b) { return a.skillId == b.skillId; });
+		handler.parameterFunctions['v'] = [](const MessageAggregate& data) { return std::to_string(-data.value); };
+		handler.parameterFunctions['n'] = [](const MessageAggregate& data) { return std::string(StringInterner::view(data.first->entityName)); };
+		handler.parameterFunctions['s'] = [](const MessageAggregate& data) { return std::string(StringInterner::view(data.first->skillName)); };
+		MapHandlers handlers;
+		for (MessageCategory category : { MessageCategory::PLAYER_OUT, MessageCategory::PLAYER_IN, MessageCategory::PET_OUT, MessageCategory::PET_IN }) {
+			for (int type = 1; type < NUM_MESSAGE_TYPES; type++) {
+				handlers[category][(MessageType)type] = handler;
+			}
+		}
+		return handlers;
+	}
+
+	bool mapTryToCombine(const MapHandlers& handlers, MessageCategory category, MessageType type, MessageAggregate& aggregate, const MessageData& data) {
+		auto byCategory = handlers.find(category);
+		if (byCategory == handlers.end()) return false;
+		auto byType = byCategory->second.find(type);
+		if (byType == byCategory->second.end()) return false;
+		for (const auto& combineFunction : byType->second.combineFunctions) {
+			if (!combineFunction(*aggregate.first, data)) return false;
+		}
+		aggregate.add(type, data);
+		return true;
+	}
+
+	void mapFormat(const MapHandlers& handlers, MessageCategory category, MessageType type, const MessageAggregate& aggregate, const std::string& outputTemplate, const std::string& color, std::string& out) {
+		out = "[col=" + color + "]";
+		for (size_t i = 0; i < outputTemplate.size(); i++) {
+			if (outputTemplate[i] != '%' || i + 1 >= outputTemplate.size()) {
+				out += outputTemplate[i];
+				continue;
+			}
+			char parameter = outputTemplate[++i];
+			auto byCategory = handlers.find(category);
+			if (byCategory == handlers.end()) continue;
+			auto byType = byCategory->second.find(type);
+			if (byType == byCategory->second.end()) continue;
+			auto function = byType->second.parameterFunctions.find(parameter);
+			if (function != byType->second.parameterFunctions.end()) out += function->second(aggregate);
+		}
+		out += "[/col]";
+	}
+
+	std::shared_ptr<const MessageData> makePayload(uint32_t skillId, int32_t value) {
+		MessageData data;
+		data.skillId = skillId;
+		data.skillName = StringInterner::intern("Fireball");
+		data.entityName = StringInterner::intern("Training Golem");
+		data.entityId = 42;
+		data.value = value;
+		return std::make_shared<const MessageData>(data);
+	}
+}
+
+int main() {
+	const size_t iterations = 1000000;
+	size_t sink = 0;
+	auto now = std::chrono::system_clock::now();
+	// Every other hit is from another skill and does not combine
+	std::shared_ptr<const MessageData> payloads[] = { makePayload(5491, -1234), makePayload(5492, -99) };
+
+	MapHandlers mapHandlers = makeMapHandlers();
+	MessageAggregate mapAggregate;
+	mapAggregate.first = payloads[0];
+	double mapCombine = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+		sink += mapTryToCombine(mapHandlers, MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, mapAggregate, *payloads[i & 1]);
+	});
+	EventMessage message(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payloads[0], now);
+	double tableCombine = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+		sink += message.tryToCombineWith(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payloads[i & 1]);
+	});
+	std::printf("combine attempt: nested maps %6.1f ns, handler table %6.1f ns\n", mapCombine, tableCombine);
+
+	const std::string outputTemplate = "%v %s on %n";
+	const std::string color = "FFFFFF";
+	auto receiver = std::make_shared<message_receiver_options_struct>();
+	receiver->outputTemplate = outputTemplate;
+	receiver->color = color;
+	std::string out;
+	EventMessage single(MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, payloads[0], now);
+	double mapRender = Tests::nanosecondsPerIteration(iterations, [&](size_t) {
+		mapFormat(mapHandlers, MessageCategory::PLAYER_OUT, MessageType::PHYSICAL, single.getAggregate(), outputTemplate, color, out);
+		sink += out.size();
+	});
+	double tableRender = Tests::nanosecondsPerIteration(iterations, [&](size_t) {
+		single.writeStringForOptions(receiver, out);
+		sink += out.size();
+	});
+	std::printf("render \"%s\": nested maps %6.1f ns, compiled template %6.1f ns\n", outputTemplate.c_str(), mapRender, tableRender);
+	std::printf("(%zu)\n", sink);
+	return 0;
+}
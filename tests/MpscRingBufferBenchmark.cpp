@@ -0,0 +1,97 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "MpscRingBuffer.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	// Roughly the size of an EventRecord, which needs the addon's headers
+	struct Payload {
+		uint64_t timepoint;
+		uint32_t producer;
+		uint32_t sequence;
+		uint32_t fields[12];
+	};
+
+	// The ingest queue before the ring: a std::queue behind a mutex
+	class MutexQueue {
+	public:
+		bool push(const Payload& value) {
+			std::lock_guard<std::mutex> lock(mutex);
+			queue.push(value);
+			return true;
+		}
+		std::optional<Payload> pop() {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (queue.empty()) return std::nullopt;
+			Payload value = queue.front();
+			queue.pop();
+			return value;
+		}
+	private:
+		std::mutex mutex;
+		std::queue<Payload> queue;
+	};
+
+	constexpr uint32_t itemsPerProducer = 1000000;
+
+	template <class Queue>
+	void run(const char* name, Queue& queue, uint32_t producerCount) {
+		std::atomic<uint32_t> producersDone = 0;
+		uint64_t consumed = 0;
+		auto start = std::chrono::steady_clock::now();
+
+		std::thread consumer([&]() {
+			for (;;) {
+				bool done = producersDone.load(std::memory_order_acquire) == producerCount;
+				bool any = false;
+				while (queue.pop()) {
+					any = true;
+					consumed++;
+				}
+				if (done && !any) return;
+			}
+		});
+		std::vector<std::thread> producers;
+		for (uint32_t p = 0; p < producerCount; p++) {
+			producers.emplace_back([&, p]() {
+				Payload payload = {};
+				payload.producer = p;
+				for (uint32_t i = 0; i < itemsPerProducer; i++) {
+					payload.sequence = i;
+					queue.push(payload);
+				}
+				producersDone.fetch_add(1, std::memory_order_release);
+			});
+		}
+		for (auto& producer : producers) producer.join();
+		consumer.join();
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		double pushes = (double)producerCount * itemsPerProducer;
+		std::printf("%-28s %u producers: %7.2f M pushes/s, %6.1f ns/push, %llu consumed\n",
+			name, producerCount, pushes / seconds / 1e6, seconds * 1e9 / pushes, (unsigned long long)consumed);
+	}
+}
+
+int main() {
+	for (uint32_t producerCount : { 1u, 2u, 4u }) {
+		MutexQueue mutexQueue;
+		run("mutex + std::queue", mutexQueue, producerCount);
+
+		auto dropNewest = std::make_unique<MpscRingBuffer<Payload, 8192>>(RingOverflowPolicy::DROP_NEWEST);
+		run("MpscRingBuffer DROP_NEWEST", *dropNewest, producerCount);
+
+		auto dropOldest = std::make_unique<MpscRingBuffer<Payload, 8192>>(RingOverflowPolicy::DROP_OLDEST);
+		run("MpscRingBuffer DROP_OLDEST", *dropOldest, producerCount);
+	}
+	return 0;
+}
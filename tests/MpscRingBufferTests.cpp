@@ -0,0 +1,142 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "MpscRingBuffer.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	struct Item {
+		uint32_t producer;
+		uint32_t sequence;
+	};
+
+	constexpr uint32_t producerCount = 4;
+	constexpr uint32_t itemsPerProducer = 200000;
+	// Small enough that the producers regularly overflow it
+	using StressRing = MpscRingBuffer<Item, 64>;
+	// Producers pause after every burst so the consumer also gets to drain on few cores
+	constexpr uint32_t burstSize = 16;
+
+	struct ConsumerResult {
+		std::vector<std::vector<uint32_t>> received = std::vector<std::vector<uint32_t>>(producerCount);
+	};
+
+	// Drains until every producer is done and the ring is empty, checking per producer FIFO order on the way
+	void consume(StressRing& ring, std::atomic<uint32_t>& producersDone, ConsumerResult& result) {
+		for (;;) {
+			bool done = producersDone.load(std::memory_order_acquire) == producerCount;
+			bool any = false;
+			while (std::optional<Item> item = ring.pop()) {
+				any = true;
+				SCT_CHECK(item->producer < producerCount);
+				std::vector<uint32_t>& received = result.received[item->producer];
+				SCT_CHECK_MESSAGE(received.empty() || received.back() < item->sequence, "producer %u: %u after %u", item->producer, item->sequence, received.back());
+				received.push_back(item->sequence);
+			}
+			if (done && !any) return;
+			if (!any) std::this_thread::yield();
+		}
+	}
+
+	void testDropNewest() {
+		StressRing ring(RingOverflowPolicy::DROP_NEWEST);
+		std::atomic<uint32_t> producersDone = 0;
+		std::vector<std::vector<uint32_t>> accepted(producerCount);
+		ConsumerResult result;
+
+		std::thread consumer(consume, std::ref(ring), std::ref(producersDone), std::ref(result));
+		std::vector<std::thread> producers;
+		for (uint32_t p = 0; p < producerCount; p++) {
+			producers.emplace_back([&, p]() {
+				for (uint32_t i = 0; i < itemsPerProducer; i++) {
+					if (ring.push({ p, i })) accepted[p].push_back(i);
+					if (i % burstSize == 0) std::this_thread::yield();
+				}
+				producersDone.fetch_add(1, std::memory_order_release);
+			});
+		}
+		for (auto& producer : producers) producer.join();
+		consumer.join();
+
+		// Every accepted element arrives exactly once, every rejected one never
+		uint64_t acceptedTotal = 0;
+		for (uint32_t p = 0; p < producerCount; p++) {
+			SCT_CHECK_MESSAGE(result.received[p] == accepted[p], "producer %u: %zu accepted, %zu received", p, accepted[p].size(), result.received[p].size());
+			acceptedTotal += accepted[p].size();
+		}
+		RingBufferStats stats = ring.getStats();
+		SCT_CHECK(stats.pushed == acceptedTotal);
+		SCT_CHECK(stats.popped == acceptedTotal);
+		SCT_CHECK(stats.pushed + stats.dropped == (uint64_t)producerCount * itemsPerProducer);
+		SCT_CHECK(stats.highWaterMark <= stats.capacity);
+		SCT_CHECK(ring.empty());
+		std::printf("DROP_NEWEST: %llu pushed, %llu rejected\n", (unsigned long long)stats.pushed, (unsigned long long)stats.dropped);
+	}
+
+	void testDropOldest() {
+		StressRing ring(RingOverflowPolicy::DROP_OLDEST);
+		std::atomic<uint32_t> producersDone = 0;
+		ConsumerResult result;
+
+		std::thread consumer(consume, std::ref(ring), std::ref(producersDone), std::ref(result));
+		std::vector<std::thread> producers;
+		for (uint32_t p = 0; p < producerCount; p++) {
+			producers.emplace_back([&, p]() {
+				for (uint32_t i = 0; i < itemsPerProducer; i++) {
+					SCT_CHECK(ring.push({ p, i }));
+					if (i % burstSize == 0) std::this_thread::yield();
+				}
+				producersDone.fetch_add(1, std::memory_order_release);
+			});
+		}
+		for (auto& producer : producers) producer.join();
+		consumer.join();
+
+		// Nothing is rejected, an element is either received once or counted as evicted
+		uint64_t receivedTotal = 0;
+		for (uint32_t p = 0; p < producerCount; p++) {
+			receivedTotal += result.received[p].size();
+			SCT_CHECK(result.received[p].empty() || result.received[p].back() < itemsPerProducer);
+		}
+		RingBufferStats stats = ring.getStats();
+		SCT_CHECK(stats.pushed == (uint64_t)producerCount * itemsPerProducer);
+		SCT_CHECK(stats.popped == receivedTotal);
+		SCT_CHECK_MESSAGE(stats.pushed == stats.popped + stats.dropped, "%llu pushed, %llu popped, %llu evicted",
+			(unsigned long long)stats.pushed, (unsigned long long)stats.popped, (unsigned long long)stats.dropped);
+		SCT_CHECK(ring.empty());
+		std::printf("DROP_OLDEST: %llu pushed, %llu evicted\n", (unsigned long long)stats.pushed, (unsigned long long)stats.dropped);
+	}
+
+	void testOverflowSingleThreaded() {
+		MpscRingBuffer<uint32_t, 4> ring(RingOverflowPolicy::DROP_NEWEST);
+		for (uint32_t i = 0; i < 4; i++) SCT_CHECK(ring.push(i));
+		SCT_CHECK(!ring.push(4));
+		SCT_CHECK(ring.size() == 4);
+
+		ring.setOverflowPolicy(RingOverflowPolicy::DROP_OLDEST);
+		SCT_CHECK(ring.push(5));
+		SCT_CHECK(ring.push(6));
+		// 0 and 1 were evicted, 4 was rejected
+		for (uint32_t expected : { 2u, 3u, 5u, 6u }) {
+			std::optional<uint32_t> value = ring.pop();
+			SCT_CHECK(value && *value == expected);
+		}
+		SCT_CHECK(!ring.pop());
+
+		RingBufferStats stats = ring.getStats();
+		SCT_CHECK(stats.pushed == 6);
+		SCT_CHECK(stats.popped == 4);
+		SCT_CHECK(stats.dropped == 3);
+		SCT_CHECK(stats.highWaterMark == 4);
+	}
+}
+
+int main() {
+	testOverflowSingleThreaded();
+	testDropNewest();
+	testDropOldest();
+	return 0;
+}
@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "NumberFormat.h"
+#include "NumberFormatReference.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+int main() {
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int32_t> values(0, 5000000);
+	std::vector<double> numbers(1 << 16);
+	for (double& number : numbers) number = values(rng);
+	const size_t iterations = 2000000;
+	size_t mask = numbers.size() - 1;
+	size_t sink = 0;
+
+	for (int precision : { -1, 0, 2 }) {
+		double reference = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+			sink += Tests::ReferenceShortenNumber(numbers[i & mask], precision).size();
+		});
+		double buffered = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+			NumberBuffer buffer;
+			sink += FormatNumber(buffer, numbers[i & mask], precision).size();
+		});
+		// Like a message render: appended to a reused output string
+		std::string out;
+		double appended = Tests::nanosecondsPerIteration(iterations, [&](size_t i) {
+			NumberBuffer buffer;
+			out.clear();
+			out += "[col=FFFFFF]";
+			out += FormatNumber(buffer, numbers[i & mask], precision, { '.', ',' });
+			out += "[/col]";
+			sink += out.size();
+		});
+		std::printf("precision %2d: ShortenNumber %6.1f ns, FormatNumber %6.1f ns, grouped and appended %6.1f ns\n", precision, reference, buffered, appended);
+	}
+	std::printf("(%zu)\n", sink);
+	return 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace GW2_SCT::Tests {
+	// ShortenNumber as it was before FormatNumber replaced it, the behaviour FormatNumber has to keep
+	inline std::string ReferenceShortenNumber(double number, int precision) {
+		if (std::isnan(number) || std::isinf(number) || number < 0) {
+			return "0";
+		}
+		if (precision == -1) {
+			return std::to_string(static_cast<long long>(std::round(number)));
+		}
+
+		precision = std::max(0, std::min(3, precision));
+
+		auto cleanDecimal = [](std::string str) -> std::string {
+			if (str.find('.') != std::string::npos) {
+				str.erase(str.find_last_not_of('0') + 1);
+				if (str.back() == '.') {
+					str.pop_back();
+				}
+			}
+			return str;
+		};
+
+		auto formatValue = [&cleanDecimal](double value, const std::string& suffix, int prec) -> std::string {
+			std::ostringstream oss;
+			oss << std::fixed << std::setprecision(prec) << value;
+			return cleanDecimal(oss.str()) + suffix;
+		};
+
+		if (number >= 1e12) {
+			return formatValue(number / 1e12, "T", precision);
+		}
+		else if (number >= 1e9) {
+			return formatValue(number / 1e9, "B", precision);
+		}
+		else if (number >= 1e6) {
+			return formatValue(number / 1e6, "M", precision);
+		}
+		else if (number >= 1e3) {
+			return formatValue(number / 1e3, "k", precision);
+		}
+		else {
+			if (precision == 0) {
+				return std::to_string(static_cast<int>(std::round(number)));
+			}
+			else {
+				std::ostringstream oss;
+				oss << std::fixed << std::setprecision(precision) << number;
+				return cleanDecimal(oss.str());
+			}
+		}
+	}
+}
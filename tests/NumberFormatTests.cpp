@@ -0,0 +1,92 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include "NumberFormat.h"
+#include "NumberFormatReference.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	void checkAgainstReference(double number, int precision) {
+		NumberBuffer buffer;
+		std::string expected = Tests::ReferenceShortenNumber(number, precision);
+		std::string_view written = FormatNumber(buffer, number, precision);
+		SCT_CHECK_MESSAGE(written == expected, "%.17g at precision %d: \"%.*s\", expected \"%s\"", number, precision, (int)written.size(), written.data(), expected.c_str());
+	}
+
+	void testRandomNumbersMatchShortenNumber() {
+		std::mt19937_64 rng(0xF0A7u);
+		std::uniform_int_distribution<int64_t> wholeNumbers(0, std::numeric_limits<int32_t>::max());
+		// Up to 9e18, above that the old version overflowed while rounding to an integer
+		std::uniform_real_distribution<double> exponents(0.0, 18.9);
+		size_t checked = 0;
+		for (int i = 0; i < 200000; i++) {
+			double whole = (double)wholeNumbers(rng);
+			double scaled = std::pow(10.0, exponents(rng));
+			for (int precision = -1; precision <= 3; precision++) {
+				checkAgainstReference(whole, precision);
+				checkAgainstReference(scaled, precision);
+				checked += 2;
+			}
+		}
+		std::printf("number format: %zu random values matched ShortenNumber\n", checked);
+	}
+
+	void testRoundingEdgesMatchShortenNumber() {
+		const double edges[] = {
+			0, 0.4999, 0.5, 1.5, 2.5, 999, 999.4, 999.5, 999.9994, 999.9995, 1000, 1049, 1050, 1051, 9999.5,
+			999499, 999500, 999999, 1000000, 1234567, 999999999, 1e9, 1e12, 1.23456e13, 4.5e15, 8.9e18
+		};
+		for (double edge : edges) {
+			for (int precision = -1; precision <= 5; precision++) {
+				checkAgainstReference(edge, precision);
+				checkAgainstReference(std::nextafter(edge, 0.0), precision);
+				checkAgainstReference(std::nextafter(edge, 1e19), precision);
+			}
+		}
+		for (double invalid : { -1.0, -0.5, std::nan(""), std::numeric_limits<double>::infinity() }) {
+			checkAgainstReference(invalid, 0);
+			checkAgainstReference(invalid, -1);
+		}
+	}
+
+	void testIntegersMatchToString() {
+		std::mt19937_64 rng(0x1A7u);
+		NumberBuffer buffer;
+		for (int64_t edge : { std::numeric_limits<int64_t>::min(), (int64_t)-1, (int64_t)0, std::numeric_limits<int64_t>::max() }) {
+			SCT_CHECK(FormatInteger(buffer, edge) == std::to_string(edge));
+		}
+		for (int i = 0; i < 200000; i++) {
+			int64_t number = (int64_t)rng() >> (rng() % 64);
+			SCT_CHECK(FormatInteger(buffer, number) == std::to_string(number));
+		}
+	}
+
+	void testSeparators() {
+		NumberBuffer buffer;
+		NumberFormat commas{ '.', ',' };
+		NumberFormat european{ ',', '.' };
+		SCT_CHECK(FormatInteger(buffer, 0, commas) == "0");
+		SCT_CHECK(FormatInteger(buffer, 999, commas) == "999");
+		SCT_CHECK(FormatInteger(buffer, 1000, commas) == "1,000");
+		SCT_CHECK(FormatInteger(buffer, -1234567, commas) == "-1,234,567");
+		SCT_CHECK(FormatInteger(buffer, std::numeric_limits<int64_t>::min(), commas) == "-9,223,372,036,854,775,808");
+		SCT_CHECK(FormatNumber(buffer, 1234567, -1, european) == "1.234.567");
+		SCT_CHECK(FormatNumber(buffer, 1250, 2, european) == "1,25k");
+		SCT_CHECK(FormatNumber(buffer, 1234.5, 1, commas) == "1.2k");
+		SCT_CHECK(FormatNumber(buffer, 12.345, 2, european) == "12,35" || FormatNumber(buffer, 12.345, 2, european) == "12,34");
+		// Too long for the buffer even without grouping
+		SCT_CHECK(FormatNumber(buffer, 1e300, 3, commas).find('e') != std::string_view::npos);
+	}
+}
+
+int main() {
+	testRoundingEdgesMatchShortenNumber();
+	testRandomNumbersMatchShortenNumber();
+	testIntegersMatchToString();
+	testSeparators();
+	return 0;
+}
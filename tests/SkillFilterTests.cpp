@@ -0,0 +1,158 @@
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SkillFilterStructures.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	// The verdict message_receiver_options_struct::isSkillFiltered gave before the filters were compiled:
+	// every matching filter is collected, the most specific ones decide and ALLOW wins ties.
+	bool referenceIsFiltered(uint32_t skillId, std::string_view skillName, const std::vector<std::string>& assignedFilterSets, const SkillFilterManager& filterManager) {
+		std::vector<std::pair<FilterAction, int>> matchingFilters;
+		FilterAction combinedDefaultAction = FilterAction::ALLOW;
+
+		for (const std::string& filterSetName : assignedFilterSets) {
+			auto filterSet = filterManager.getFilterSet(filterSetName);
+			if (!filterSet) continue;
+
+			if (filterSet->filterSet.defaultAction == FilterAction::BLOCK) {
+				combinedDefaultAction = FilterAction::BLOCK;
+			}
+
+			for (const auto& filter : filterSet->filterSet.filters) {
+				if (filter.matches(skillId, skillName)) {
+					matchingFilters.push_back({ filter.action, filter.getSpecificityScore() });
+				}
+			}
+		}
+
+		if (matchingFilters.empty()) {
+			return combinedDefaultAction == FilterAction::BLOCK;
+		}
+
+		int highestSpecificity = -1;
+		for (const auto& filterPair : matchingFilters) {
+			if (filterPair.second > highestSpecificity) highestSpecificity = filterPair.second;
+		}
+		bool hasAllow = false;
+		for (const auto& filterPair : matchingFilters) {
+			if (filterPair.second == highestSpecificity && filterPair.first == FilterAction::ALLOW) hasAllow = true;
+		}
+		return !hasAllow;
+	}
+
+	const std::vector<std::string> skillNames = { "Fireball", "Lava Font", "Meteor Shower", "Burning", "Bleeding", "Dragon's Tooth", "Phoenix", "" };
+	constexpr uint32_t maxId = std::numeric_limits<uint32_t>::max();
+
+	// Ids cluster in a small window so that filters overlap, plus the edges of the id space
+	uint32_t randomSkillId(std::mt19937& rng) {
+		switch (rng() % 8) {
+		case 0: return 0;
+		case 1: return maxId - rng() % 4;
+		default: return rng() % 64;
+		}
+	}
+
+	SkillFilter randomFilter(std::mt19937& rng) {
+		SkillFilter filter;
+		filter.type = static_cast<FilterType>(rng() % 3);
+		filter.action = rng() % 2 == 0 ? FilterAction::ALLOW : FilterAction::BLOCK;
+		switch (filter.type) {
+		case FilterType::SKILL_ID:
+			filter.skillId = randomSkillId(rng);
+			break;
+		case FilterType::SKILL_NAME:
+			filter.skillName = skillNames[rng() % skillNames.size()];
+			break;
+		case FilterType::SKILL_ID_RANGE:
+			filter.idRange.start = randomSkillId(rng);
+			// Mostly well formed, sometimes reversed so that the range matches nothing
+			filter.idRange.end = rng() % 6 == 0 ? randomSkillId(rng) : filter.idRange.start + std::min<uint32_t>(rng() % 24, maxId - filter.idRange.start);
+			break;
+		}
+		return filter;
+	}
+
+	void testRandomFilterSets() {
+		std::mt19937 rng(0x5C7F11u);
+		const std::vector<std::string> setNames = { "A", "B", "C", "D", "Missing" };
+		size_t lookups = 0;
+
+		for (int round = 0; round < 4000; round++) {
+			SkillFilterManager filterManager;
+			for (size_t i = 0; i + 1 < setNames.size(); i++) {
+				if (rng() % 4 == 0) continue;
+				auto filterSet = filterManager.createFilterSet(setNames[i]);
+				filterSet->filterSet.defaultAction = rng() % 4 == 0 ? FilterAction::BLOCK : FilterAction::ALLOW;
+				size_t filterCount = rng() % 12;
+				for (size_t f = 0; f < filterCount; f++) {
+					filterSet->filterSet.filters.push_back(randomFilter(rng));
+				}
+			}
+
+			std::vector<std::string> assigned;
+			for (const std::string& name : setNames) {
+				if (rng() % 2 == 0) assigned.push_back(name);
+			}
+
+			CompiledSkillFilter compiled;
+			compiled.compile(assigned, filterManager);
+			for (int i = 0; i < 400; i++) {
+				uint32_t skillId = randomSkillId(rng);
+				const std::string& skillName = skillNames[rng() % skillNames.size()];
+				bool expected = referenceIsFiltered(skillId, skillName, assigned, filterManager);
+				SCT_CHECK_MESSAGE(compiled.isFiltered(skillId, skillName) == expected, "round %d, skill %u \"%s\"", round, skillId, skillName.c_str());
+				lookups++;
+			}
+		}
+		std::printf("skill filter: %zu random lookups matched the reference\n", lookups);
+	}
+
+	void testEdgesOfIdSpace() {
+		SkillFilterManager filterManager;
+		auto filterSet = filterManager.createFilterSet("Edges");
+		SkillFilter wholeSpace;
+		wholeSpace.type = FilterType::SKILL_ID_RANGE;
+		wholeSpace.idRange = { 0, maxId };
+		filterSet->filterSet.filters.push_back(wholeSpace);
+		SkillFilter allowLast;
+		allowLast.type = FilterType::SKILL_ID_RANGE;
+		allowLast.action = FilterAction::ALLOW;
+		allowLast.idRange = { maxId, maxId };
+		filterSet->filterSet.filters.push_back(allowLast);
+
+		CompiledSkillFilter compiled;
+		compiled.compile({ "Edges" }, filterManager);
+		SCT_CHECK(compiled.isFiltered(0, "Fireball"));
+		SCT_CHECK(compiled.isFiltered(maxId - 1, "Fireball"));
+		SCT_CHECK(!compiled.isFiltered(maxId, "Fireball"));
+	}
+
+	void testGenerationAdvances() {
+		SkillFilterManager first;
+		SkillFilterManager second;
+		SCT_CHECK(first.getGeneration() != second.getGeneration());
+
+		uint64_t generation = first.getGeneration();
+		first.createFilterSet("A");
+		SCT_CHECK(first.getGeneration() != generation);
+		generation = first.getGeneration();
+		first.markChanged();
+		SCT_CHECK(first.getGeneration() != generation);
+		generation = first.getGeneration();
+		SCT_CHECK(!first.removeFilterSet("Missing"));
+		SCT_CHECK(first.getGeneration() == generation);
+	}
+}
+
+int main() {
+	testRandomFilterSets();
+	testEdgesOfIdSpace();
+	testGenerationAdvances();
+	return 0;
+}
@@ -0,0 +1,126 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StringInterner.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	std::atomic<size_t> allocations = 0;
+
+	struct AllocationCounter {
+		size_t start = allocations.load();
+		size_t count() const { return allocations.load() - start; }
+	};
+}
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	constexpr uint32_t threadCount = 4;
+	constexpr uint32_t namesPerKind = 500;
+
+	// Names are prepared up front, so that only the interner can allocate while counting
+	std::vector<std::string> makeNames(const char* prefix, uint32_t count) {
+		std::vector<std::string> names;
+		for (uint32_t i = 0; i < count; i++) names.push_back(prefix + std::to_string(i));
+		return names;
+	}
+
+	// What the combat callback does after SCTMain::Init reserved the interner
+	void testReservedInterningDoesNotAllocate() {
+		std::vector<std::string> skills = makeNames("Skill ", namesPerKind);
+		std::vector<std::string> agents = makeNames("Agent ", namesPerKind);
+		StringInterner::reserve(4 * namesPerKind, 64 * 1024);
+
+		AllocationCounter counter;
+		for (int round = 0; round < 3; round++) {
+			for (uint32_t i = 0; i < namesPerKind; i++) {
+				uint32_t other = (i * 7) % namesPerKind;
+				EventNames names = StringInterner::internEventNames(i, skills[i].c_str(), i, agents[i].c_str(), other, agents[other].c_str());
+				SCT_CHECK(StringInterner::view(names.skillName) == skills[i]);
+				SCT_CHECK(StringInterner::view(names.srcName) == agents[i]);
+				SCT_CHECK(StringInterner::view(names.dstName) == agents[other]);
+			}
+		}
+		SCT_CHECK_MESSAGE(counter.count() == 0, "%zu allocations while interning into reserved storage", counter.count());
+		SCT_CHECK(StringInterner::size() == 2 * namesPerKind);
+	}
+
+	void testKeyedLookupsHitWithoutTheTable() {
+		EventNames first = StringInterner::internEventNames(9001, "Meteor Shower", 77, "Weaver", 78, "Training Golem");
+		StringInternerStats before = StringInterner::getStats();
+		EventNames second = StringInterner::internEventNames(9001, "Meteor Shower", 77, "Weaver", 78, "Training Golem");
+		StringInternerStats after = StringInterner::getStats();
+		SCT_CHECK(first.skillName == second.skillName && first.srcName == second.srcName && first.dstName == second.dstName);
+		SCT_CHECK(after.keyedHits - before.keyedHits == 3);
+		SCT_CHECK(after.strings == before.strings);
+
+		// A renamed agent keeps its id but gets the handle of its new name
+		EventNames renamed = StringInterner::internEventNames(9001, "Meteor Shower", 77, "Weaver (Renamed)", 78, "Training Golem");
+		SCT_CHECK(renamed.srcName != first.srcName);
+		SCT_CHECK(StringInterner::view(renamed.srcName) == "Weaver (Renamed)");
+		SCT_CHECK(StringInterner::intern("Weaver (Renamed)") == renamed.srcName);
+
+		// Missing names stay empty, the others are still resolved
+		EventNames partial = StringInterner::internEventNames(9001, nullptr, 77, "", 78, "Training Golem");
+		SCT_CHECK(partial.skillName == 0 && partial.srcName == 0 && partial.dstName == first.dstName);
+		SCT_CHECK(StringInterner::c_str(0) == nullptr);
+	}
+
+	// Threads intern the same names under colliding and differing ids, equal strings must end up with one handle
+	void testConcurrentInterningAgrees() {
+		std::vector<std::string> names = makeNames("Shared Name ", 3000);
+		std::vector<std::vector<InternedString>> handles(threadCount, std::vector<InternedString>(names.size()));
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadCount; t++) {
+			threads.emplace_back([&, t]() {
+				for (size_t n = 0; n < names.size(); n++) {
+					// 7 is coprime to the name count, so every thread visits every name in its own order
+					size_t i = (n * 7 + t * 101) % names.size();
+					size_t j = (i + 1) % names.size();
+					EventNames interned = StringInterner::internEventNames((uint32_t)(i + t), names[i].c_str(), i, names[j].c_str(), j * (t + 1), names[i].c_str());
+					SCT_CHECK(interned.skillName == interned.dstName);
+					SCT_CHECK(StringInterner::view(interned.srcName) == names[j]);
+					handles[t][i] = interned.skillName;
+					if (n % 64 == 0) std::this_thread::yield();
+				}
+			});
+		}
+		for (auto& thread : threads) thread.join();
+
+		for (size_t i = 0; i < names.size(); i++) {
+			InternedString expected = StringInterner::intern(names[i]);
+			SCT_CHECK(StringInterner::view(expected) == names[i]);
+			for (uint32_t t = 0; t < threadCount; t++) {
+				SCT_CHECK_MESSAGE(handles[t][i] == expected, "thread %u got %u for \"%s\", expected %u", t, handles[t][i], names[i].c_str(), expected);
+			}
+		}
+		StringInternerStats stats = StringInterner::getStats();
+		std::printf("interner: %zu strings, %llu lookups, %llu keyed hits\n", stats.strings, (unsigned long long)stats.lookups, (unsigned long long)stats.keyedHits);
+	}
+}
+
+int main() {
+	testReservedInterningDoesNotAllocate();
+	testKeyedLookupsHitWithoutTheTable();
+	testConcurrentInterningAgrees();
+	return 0;
+}
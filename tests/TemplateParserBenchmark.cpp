@@ -0,0 +1,34 @@
+#include <cstdio>
+#include <map>
+#include <string>
+#include "TemplateParser.h"
+#include "TemplateParserReference.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+int main() {
+	const std::map<char, std::string> parameters = { { 'v', "" }, { 'n', "" }, { 's', "" }, { 'c', "" }, { 'i', "" }, { 'd', "" } };
+	// A plain default template, one with a color tag and one with several tags like a rendered message
+	const std::string templates[] = {
+		"%v",
+		"[col=%c]%n[/col]: %v",
+		"[col=FFFFFF][icon=736][/icon] [col=FF0000]1.2k[/col] [[3 hits]][/col]"
+	};
+	const size_t iterations = 200000;
+	size_t sink = 0;
+
+	for (const std::string& source : templates) {
+		double regex = Tests::nanosecondsPerIteration(iterations / 10, [&](size_t) {
+			sink += Tests::ReferenceValidateTemplate(source, parameters);
+		});
+		TemplateParseResult result;
+		double parser = Tests::nanosecondsPerIteration(iterations, [&](size_t) {
+			TemplateParser::parse(source, TemplateSyntax::TEMPLATE, &parameters, result);
+			sink += result.valid() + result.nodes.size();
+		});
+		std::printf("%-72s regex validate %8.1f ns, TemplateParser::parse %6.1f ns\n", source.c_str(), regex, parser);
+	}
+	std::printf("(%zu)\n", sink);
+	return 0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace GW2_SCT::Tests {
+	// TemplateInterpreter::validate as it was before TemplateParser, building a std::regex per tag
+	inline bool ReferenceValidateTemplate(std::string t, std::map<char, std::string> params) {
+		int openColors = 0;
+		std::vector<std::string> currentCommands;
+		std::string tempText;
+
+		for (auto it = t.begin(); it != t.end(); it++) {
+			switch (*it)
+			{
+			case ']':
+				it++;
+				if (it == t.end() || *it != ']') return false;
+				break;
+			case '[':
+				it++;
+				if (it == t.end()) return false;
+				switch (*it)
+				{
+				case '[':
+					break;
+				case '/':
+					it++;
+					if (it == t.end()) return false;
+					tempText = "";
+					while (it != t.end() && *it != ']') {
+						tempText += *it;
+						it++;
+					}
+					if (it == t.end()) return false;
+					if (currentCommands.empty()) return false;
+					if (tempText.compare(currentCommands.back()) != 0) return false;
+					currentCommands.pop_back();
+					if (tempText == "col") {
+						openColors--;
+					}
+					break;
+				default:
+					tempText = "";
+					while (it != t.end() && *it != '=' && *it != ']') {
+						tempText += *it;
+						it++;
+					}
+					if (it == t.end()) return false;
+					currentCommands.push_back(tempText);
+					if (tempText == "col") {
+						tempText = "";
+						if (*it != '=') return false;
+						it++;
+						while (it != t.end() && *it != ']') {
+							tempText += *it;
+							it++;
+						}
+						if (it == t.end()) return false;
+						if (std::regex_match(tempText, std::regex("(%c|[0-9A-F]{6})"))) {
+							openColors++;
+						}
+						else {
+							return false;
+						}
+					}
+					else if (tempText == "icon") {
+						tempText = "";
+						if (*it != '=') return false;
+						it++;
+						while (it != t.end() && *it != ']') {
+							tempText += *it;
+							it++;
+						}
+						if (it == t.end()) return false;
+						if (std::regex_match(tempText, std::regex("[0-9]+"))) {
+							openColors++;
+						}
+						else {
+							return false;
+						}
+					}
+					else {
+						return false;
+					}
+					break;
+				}
+				break;
+			case '%':
+				it++;
+				if (it == t.end()) return false;
+				if (*it != '%' && params.find(*it) == params.end()) {
+					return false;
+				}
+				break;
+			}
+		}
+		return openColors == 0;
+	}
+}
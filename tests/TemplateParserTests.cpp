@@ -0,0 +1,174 @@
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "TemplateParser.h"
+#include "TestCommon.h"
+
+using namespace GW2_SCT;
+
+namespace {
+	const std::map<char, std::string> parameters = { { 'v', "" }, { 'n', "" }, { 's', "" }, { 'c', "" }, { 'i', "" }, { 'd', "" } };
+
+	bool isInside(std::string_view source, std::string_view part) {
+		return part.data() >= source.data() && part.data() + part.size() <= source.data() + source.size();
+	}
+
+	// Writes parsed nodes back as markup, the parse of the result has to give the same markup again
+	std::string serialize(const TemplateParseResult& result, TemplateSyntax syntax) {
+		std::string out;
+		for (const TemplateNode& node : result.nodes) {
+			switch (node.type) {
+			case TemplateNode::Type::TEXT:
+				for (char c : node.text) {
+					if (c == '[' || c == ']' || (c == '%' && syntax == TemplateSyntax::TEMPLATE)) out += c;
+					out += c;
+				}
+				break;
+			case TemplateNode::Type::PARAMETER:
+				out += '%';
+				out += node.parameter;
+				break;
+			case TemplateNode::Type::COLOR_BEGIN:
+				out += "[col=";
+				if (node.parameter != 0) {
+					out += '%';
+					out += node.parameter;
+				}
+				else out += node.text;
+				out += ']';
+				break;
+			case TemplateNode::Type::COLOR_END:
+				out += "[/col]";
+				break;
+			case TemplateNode::Type::ICON_BEGIN:
+				out += "[icon=";
+				out += node.text;
+				out += ']';
+				break;
+			case TemplateNode::Type::ICON_END:
+				out += "[/icon]";
+				break;
+			}
+		}
+		return out;
+	}
+
+	void checkResult(std::string_view source, TemplateSyntax syntax, const std::map<char, std::string>* allowed, const TemplateParseResult& result) {
+		if (!result.valid()) {
+			SCT_CHECK_MESSAGE(result.errorPosition < source.size(), "error %d at %zu in \"%.*s\"", (int)result.error, result.errorPosition, (int)source.size(), source.data());
+			return;
+		}
+		SCT_CHECK(result.errorPosition == 0);
+
+		size_t lastPosition = 0;
+		std::vector<TemplateNode::Type> open;
+		for (const TemplateNode& node : result.nodes) {
+			SCT_CHECK_MESSAGE(node.position < source.size() && node.position >= lastPosition, "node at %zu in \"%.*s\"", node.position, (int)source.size(), source.data());
+			lastPosition = node.position;
+			switch (node.type) {
+			case TemplateNode::Type::TEXT:
+				SCT_CHECK(!node.text.empty() && isInside(source, node.text));
+				break;
+			case TemplateNode::Type::PARAMETER:
+				SCT_CHECK(syntax == TemplateSyntax::TEMPLATE);
+				SCT_CHECK(allowed == nullptr || allowed->count(node.parameter) == 1);
+				break;
+			case TemplateNode::Type::COLOR_BEGIN:
+			case TemplateNode::Type::ICON_BEGIN:
+				SCT_CHECK(isInside(source, node.text));
+				SCT_CHECK(node.rgb >= 0 && node.rgb <= 0xFFFFFF);
+				open.push_back(node.type);
+				break;
+			case TemplateNode::Type::COLOR_END:
+				SCT_CHECK(!open.empty() && open.back() == TemplateNode::Type::COLOR_BEGIN);
+				open.pop_back();
+				break;
+			case TemplateNode::Type::ICON_END:
+				SCT_CHECK(!open.empty() && open.back() == TemplateNode::Type::ICON_BEGIN);
+				open.pop_back();
+				break;
+			}
+		}
+		SCT_CHECK(open.empty());
+
+		std::string markup = serialize(result, syntax);
+		TemplateParseResult reparsed = TemplateParser::parse(markup, syntax, allowed);
+		SCT_CHECK_MESSAGE(reparsed.valid() && serialize(reparsed, syntax) == markup, "\"%.*s\" does not round trip through \"%s\"", (int)source.size(), source.data(), markup.c_str());
+	}
+
+	std::string randomMarkup(std::mt19937& rng) {
+		static const std::vector<std::string> fragments = {
+			"[", "]", "[[", "]]", "%", "%%", "%v", "%n", "%c", "%x", "[col=", "[col=%c]", "[col=FF00AA]", "FF00AA", "ff00aa", "[/col]",
+			"[icon=", "[icon=736]", "4294967296", "[/icon]", "[/", "[]", "=", "Hit ", "x", "\xC3\xA9", std::string(1, '\0')
+		};
+		std::string out;
+		size_t count = rng() % 12;
+		for (size_t i = 0; i < count; i++) {
+			if (rng() % 8 == 0) out += (char)(rng() % 256);
+			else out += fragments[rng() % fragments.size()];
+		}
+		return out;
+	}
+
+	std::string mutate(std::mt19937& rng, std::string markup) {
+		size_t edits = 1 + rng() % 3;
+		for (size_t i = 0; i < edits; i++) {
+			size_t at = markup.empty() ? 0 : rng() % markup.size();
+			switch (rng() % 3) {
+			case 0: if (!markup.empty()) markup.erase(at, 1); break;
+			case 1: markup.insert(markup.begin() + at, "[]%=/"[rng() % 5]); break;
+			default: if (!markup.empty()) markup[at] = (char)(rng() % 256); break;
+			}
+		}
+		return markup;
+	}
+
+	void testRandomMarkup() {
+		const std::string templates[] = {
+			"[col=FFFFFF]%v[/col] %s on %n",
+			"[col=%c]%n[/col]: [icon=736][/icon] %v (%d)",
+			"%%%v [[crit]] [col=00FF00][col=FF0000]nested[/col][/col]"
+		};
+		std::mt19937 rng(0x7E3Au);
+		TemplateParseResult reused;
+		size_t valid = 0;
+		const size_t rounds = 300000;
+		for (size_t round = 0; round < rounds; round++) {
+			std::string source = round % 2 == 0 ? randomMarkup(rng) : mutate(rng, templates[rng() % std::size(templates)]);
+			for (TemplateSyntax syntax : { TemplateSyntax::TEMPLATE, TemplateSyntax::RENDERED }) {
+				for (const std::map<char, std::string>* allowed : { &parameters, (const std::map<char, std::string>*)nullptr }) {
+					TemplateParser::parse(source, syntax, allowed, reused);
+					checkResult(source, syntax, allowed, reused);
+					TemplateParseResult fresh = TemplateParser::parse(source, syntax, allowed);
+					SCT_CHECK(fresh.error == reused.error && fresh.errorPosition == reused.errorPosition && fresh.nodes.size() == reused.nodes.size());
+					if (reused.valid()) valid++;
+				}
+			}
+		}
+		std::printf("template parser: %zu of %zu random parses valid\n", valid, rounds * 4);
+		SCT_CHECK(valid > rounds / 10);
+	}
+
+	void testKnownMarkup() {
+		TemplateParseResult result = TemplateParser::parse("[col=%c]%n[/col] [icon=4294967296][/icon]", TemplateSyntax::TEMPLATE, &parameters);
+		SCT_CHECK(result.valid() && result.nodes.size() == 6);
+		SCT_CHECK(result.nodes[0].type == TemplateNode::Type::COLOR_BEGIN && result.nodes[0].parameter == 'c');
+		SCT_CHECK(result.nodes[4].type == TemplateNode::Type::ICON_BEGIN && result.nodes[4].iconId == 0);
+
+		SCT_CHECK(TemplateParser::parse("[col=%c]x[/col]", TemplateSyntax::RENDERED).error == TemplateError::INVALID_COLOR);
+		SCT_CHECK(TemplateParser::parse("%q", TemplateSyntax::TEMPLATE, &parameters).error == TemplateError::UNKNOWN_PARAMETER);
+		SCT_CHECK(TemplateParser::parse("100%", TemplateSyntax::RENDERED).valid());
+		TemplateParseResult unclosed = TemplateParser::parse("ab[col=FF0000]c", TemplateSyntax::RENDERED);
+		SCT_CHECK(unclosed.error == TemplateError::UNCLOSED_TAG && unclosed.errorPosition == 2);
+		SCT_CHECK(TemplateParser::parse("a]b", TemplateSyntax::RENDERED).error == TemplateError::LONE_CLOSING_BRACKET);
+		SCT_CHECK(TemplateParser::parse("[icon=1][/col]", TemplateSyntax::RENDERED).error == TemplateError::UNEXPECTED_CLOSING_TAG);
+	}
+}
+
+int main() {
+	testKnownMarkup();
+	testRandomMarkup();
+	return 0;
+}
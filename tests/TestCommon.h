@@ -0,0 +1,34 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal checks for the headless tests, the first failure ends the test with a non-zero exit code
+#define SCT_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			std::exit(1); \
+		} \
+	} while (false)
+
+#define SCT_CHECK_MESSAGE(condition, ...) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: check failed: %s: ", __FILE__, __LINE__, #condition); \
+			std::fprintf(stderr, __VA_ARGS__); \
+			std::fprintf(stderr, "\n"); \
+			std::exit(1); \
+		} \
+	} while (false)
+
+namespace GW2_SCT::Tests {
+	// Runs fn iterations times and returns the mean nanoseconds per iteration
+	template <class F>
+	double nanosecondsPerIteration(size_t iterations, F&& fn) {
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; i++) fn(i);
+		auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+		return elapsed.count() / (double)iterations;
+	}
+}